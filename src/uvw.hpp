@@ -1,26 +1,37 @@
 #include "uvw/async.h"
+#include "uvw/channel.hpp"
 #include "uvw/check.h"
 #include "uvw/config.h"
+#include "uvw/coroutine.hpp"
 #include "uvw/dns.h"
 #include "uvw/emitter.h"
 #include "uvw/enum.hpp"
+#include "uvw/file_stream.h"
 #include "uvw/fs.h"
 #include "uvw/fs_event.h"
 #include "uvw/fs_poll.h"
+#include "uvw/fs_walker.h"
 #include "uvw/handle.hpp"
 #include "uvw/idle.h"
 #include "uvw/lib.h"
 #include "uvw/loop.h"
+#include "uvw/loop_group.h"
+#include "uvw/mmap_file.h"
 #include "uvw/pipe.h"
 #include "uvw/poll.h"
+#include "uvw/pool.h"
 #include "uvw/prepare.h"
 #include "uvw/process.h"
 #include "uvw/request.hpp"
 #include "uvw/resource.hpp"
+#include "uvw/scheduler.hpp"
 #include "uvw/signal.h"
+#include "uvw/small_function.hpp"
+#include "uvw/stat_cache.h"
 #include "uvw/tcp.h"
 #include "uvw/thread.h"
 #include "uvw/timer.h"
+#include "uvw/timer_wheel.h"
 #include "uvw/tty.h"
 #include "uvw/udp.h"
 #include "uvw/util.h"
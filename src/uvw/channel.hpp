@@ -0,0 +1,175 @@
+#ifndef UVW_CHANNEL_INCLUDE_H
+#define UVW_CHANNEL_INCLUDE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <uv.h>
+#include "async.h"
+#include "config.h"
+#include "emitter.h"
+#include "handle.hpp"
+#include "loop.h"
+
+namespace uvw {
+
+/**
+ * @brief Channel event.
+ *
+ * It will be emitted by channel according with its functionalities.
+ */
+template<typename T>
+struct channel_event {
+    T data; /*!< The value sent through the channel. */
+};
+
+/**
+ * @brief The channel wrapper.
+ *
+ * A channel moves values from any thread to the loop it belongs to.<br/>
+ * Producers push values into an unbounded lock-free queue (multiple producers,
+ * single consumer) and wake up the loop through an async handle. The loop
+ * drains the queue in batches and emits a channel event for each value, in the
+ * order in which the values were sent by a given producer.
+ *
+ * Like handles, a channel keeps itself alive until it's closed. Values still
+ * in the queue when the channel is destroyed are discarded.
+ *
+ * To create a `channel` through a `loop`, no arguments are required.
+ *
+ * @note
+ * The underlying async handle is visible when walking the loop. Closing it
+ * closes the channel as well.
+ *
+ * @tparam T Type of the values sent through the channel.
+ */
+template<typename T>
+class channel final: public emitter<channel<T>, close_event, channel_event<T>>, public std::enable_shared_from_this<channel<T>> {
+    // upper bound to the values consumed per wakeup, so that other handles get a chance to run
+    static constexpr std::size_t BATCH_SIZE = 1024u;
+
+    struct node {
+        std::atomic<node *> next{};
+        std::optional<T> value{};
+    };
+
+    void drain() {
+        for(std::size_t count{}; count < BATCH_SIZE; ++count) {
+            node *next = tail->next.load(std::memory_order_acquire);
+
+            if(!next || waker->closing()) {
+                return;
+            }
+
+            channel_event<T> event{std::move(*next->value)};
+            next->value.reset();
+            delete std::exchange(tail, next);
+            this->publish(std::move(event));
+        }
+
+        if(!waker->closing()) {
+            waker->send();
+        }
+    }
+
+public:
+    explicit channel(loop::token, std::shared_ptr<loop> ref)
+        : owner{std::move(ref)},
+          waker{},
+          self{},
+          head{new node{}},
+          tail{head.load(std::memory_order_relaxed)} {}
+
+    channel(const channel &) = delete;
+    channel(channel &&) = delete;
+
+    channel &operator=(const channel &) = delete;
+    channel &operator=(channel &&) = delete;
+
+    ~channel() noexcept {
+        while(tail) {
+            delete std::exchange(tail, tail->next.load(std::memory_order_acquire));
+        }
+    }
+
+    /**
+     * @brief Initializes the channel.
+     * @return Underlying return value.
+     */
+    int init() {
+        waker = owner->uninitialized_resource<async_handle>();
+
+        waker->template on<async_event>([this](const async_event &, async_handle &) {
+            drain();
+        });
+
+        waker->template on<close_event>([this](const close_event &, async_handle &) {
+            [[maybe_unused]] auto ptr = std::move(self);
+            this->publish(close_event{});
+        });
+
+        const auto err = waker->init();
+
+        if(err == 0) {
+            self = this->shared_from_this();
+        }
+
+        return err;
+    }
+
+    /**
+     * @brief Gets the loop from which the channel was originated.
+     * @return A reference to a loop instance.
+     */
+    [[nodiscard]] loop &parent() const noexcept {
+        return *owner;
+    }
+
+    /**
+     * @brief Sends a value to the loop.
+     *
+     * It's safe to call this function from any thread, as long as the channel
+     * isn't closed in the meantime.<br/>
+     * A channel event is emitted on the loop thread.
+     *
+     * @param value The value to send.
+     * @return Underlying return value.
+     */
+    int send(T value) {
+        auto *elem = new node{};
+        elem->value.emplace(std::move(value));
+        head.exchange(elem, std::memory_order_acq_rel)->next.store(elem, std::memory_order_release);
+        return waker->send();
+    }
+
+    /**
+     * @brief Checks if the channel is closing or closed.
+     * @return True if the channel is closing or closed, false otherwise.
+     */
+    [[nodiscard]] bool closing() const noexcept {
+        return waker->closing();
+    }
+
+    /**
+     * @brief Requests the channel to be closed.
+     *
+     * Values not yet received are discarded.<br/>
+     * A close event is emitted when the channel has been closed.
+     */
+    void close() noexcept {
+        waker->close();
+    }
+
+private:
+    std::shared_ptr<loop> owner;
+    std::shared_ptr<async_handle> waker;
+    std::shared_ptr<channel> self;
+    std::atomic<node *> head;
+    node *tail;
+};
+
+} // namespace uvw
+
+#endif // UVW_CHANNEL_INCLUDE_H
@@ -0,0 +1,345 @@
+#ifndef UVW_COROUTINE_INCLUDE_H
+#define UVW_COROUTINE_INCLUDE_H
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#    include <coroutine>
+#    include <exception>
+#    include <functional>
+#    include <type_traits>
+#    include <utility>
+#    include <variant>
+#    include "emitter.h"
+
+namespace uvw {
+
+/**
+ * @brief Coroutine type for fire-and-forget tasks.
+ *
+ * A task starts running as soon as it's invoked and its frame is destroyed as
+ * soon as it returns. Exceptions that escape a task terminate the program.
+ *
+ * @note
+ * The coroutine support is available only when compiling with C++20 or later.
+ */
+struct detached_task {
+    /*! @brief Promise type of the task. */
+    struct promise_type {
+        detached_task get_return_object() noexcept {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+
+        void return_void() noexcept {}
+
+        void unhandled_exception() noexcept {
+            std::terminate();
+        }
+    };
+};
+
+/**
+ * @brief Result of an awaited operation.
+ *
+ * It contains either the event emitted on completion or an error event.
+ *
+ * @tparam Type Type of the event emitted on completion.
+ */
+template<typename Type>
+class await_result {
+public:
+    /**
+     * @brief Constructs a result from the event emitted on completion.
+     * @param event The event emitted on completion.
+     */
+    explicit await_result(Type event)
+        : value{std::in_place_index<0u>, std::move(event)} {}
+
+    /**
+     * @brief Constructs a result from an error event.
+     * @param event The error event.
+     */
+    explicit await_result(error_event event)
+        : value{std::in_place_index<1u>, event} {}
+
+    /**
+     * @brief Checks if the operation succeeded.
+     * @return True in case of success, false otherwise.
+     */
+    [[nodiscard]] explicit operator bool() const noexcept {
+        return (value.index() == 0u);
+    }
+
+    /**
+     * @brief Gets the event emitted on completion.
+     *
+     * Use it only in case of success.
+     *
+     * @return A reference to the event emitted on completion.
+     */
+    [[nodiscard]] Type &operator*() noexcept {
+        return *std::get_if<0u>(&value);
+    }
+
+    /*! @copydoc operator* */
+    [[nodiscard]] const Type &operator*() const noexcept {
+        return *std::get_if<0u>(&value);
+    }
+
+    /**
+     * @brief Accesses the event emitted on completion.
+     *
+     * Use it only in case of success.
+     *
+     * @return A pointer to the event emitted on completion.
+     */
+    [[nodiscard]] Type *operator->() noexcept {
+        return std::get_if<0u>(&value);
+    }
+
+    /*! @copydoc operator-> */
+    [[nodiscard]] const Type *operator->() const noexcept {
+        return std::get_if<0u>(&value);
+    }
+
+    /**
+     * @brief Gets the error of the operation, if any.
+     * @return The error event in case of errors, an invalid one otherwise.
+     */
+    [[nodiscard]] error_event error() const noexcept {
+        const auto *elem = std::get_if<1u>(&value);
+        return elem ? *elem : error_event{0};
+    }
+
+private:
+    std::variant<Type, error_event> value;
+};
+
+/**
+ * @cond TURN_OFF_DOXYGEN
+ * Internal details not to be documented.
+ */
+
+namespace details {
+
+template<typename Elem>
+struct awaiter_node {
+    void (*fail)(awaiter_node &, error_event);
+    awaiter_node *next;
+    typename Elem::template listener_t<error_event> saved;
+    std::coroutine_handle<> coroutine;
+    bool starting;
+};
+
+template<typename Elem>
+struct awaiter_router {
+    void operator()(error_event &event, Elem &ref) const {
+        auto *curr = head;
+        typename Elem::template listener_t<error_event> saved{};
+
+        for(auto *node = curr; node; node = node->next) {
+            if(node->saved) {
+                saved = std::move(node->saved);
+            }
+        }
+
+        // the router is gone from here on, the listener it replaced is back
+        ref.template on<error_event>(std::move(saved));
+
+        // all the awaitables are settled before resuming any of them
+        for(auto *node = curr; node; node = node->next) {
+            node->fail(*node, event);
+        }
+
+        while(curr) {
+            // frames (and nodes with them) may be gone once resumed
+            auto &node = *std::exchange(curr, curr->next);
+
+            if(!node.starting) {
+                node.coroutine.resume();
+            }
+        }
+    }
+
+    awaiter_node<Elem> *head;
+};
+
+} // namespace details
+
+/**
+ * Internal details not to be documented.
+ * @endcond
+ */
+
+/**
+ * @brief Awaitable for the next event of a given type.
+ *
+ * The awaiting coroutine is suspended, the function provided starts the
+ * operation and the coroutine is resumed on the loop thread with either the
+ * event or an error event. Results are stored in the awaitable itself, that
+ * lives in the frame of the coroutine.<br/>
+ * Operations that fail or complete before the function returns don't suspend
+ * the coroutine at all.
+ *
+ * The listeners for the given event type and for error events are set aside
+ * while waiting and put back on completion. Therefore, an emitter supports
+ * only one awaitable at a time for each event type and listeners shouldn't be
+ * replaced while waiting.<br/>
+ * Awaitables for different event types can wait on the same emitter at the
+ * same time. Error events aren't bound to an operation, thus they resume all
+ * the awaitables pending on the emitter.
+ *
+ * @tparam Type Type of the event emitted on completion.
+ * @tparam Elem Type of the emitter.
+ * @tparam Func Type of the function that starts the operation.
+ */
+template<typename Type, typename Elem, typename Func>
+class event_awaiter: private details::awaiter_node<Elem> {
+    using return_type = std::invoke_result_t<Func &, Elem &>;
+    using node_type = details::awaiter_node<Elem>;
+    using router_type = details::awaiter_router<Elem>;
+
+    static_assert(std::is_void_v<return_type> || std::is_same_v<return_type, int>, "Invalid function type");
+
+    static void reject(node_type &node, error_event event) {
+        static_cast<event_awaiter &>(node).settle(event);
+    }
+
+    template<typename Event>
+    void settle(Event &&event) {
+        value.template emplace<std::decay_t<Event>>(std::forward<Event>(event));
+        elem.template on<Type>(std::move(previous));
+    }
+
+    void link() {
+        auto &listener = elem.template handler<error_event>();
+
+        if(auto *router = listener.template target<router_type>(); router) {
+            this->next = std::exchange(router->head, static_cast<node_type *>(this));
+        } else {
+            // the listener replaced is put back once no awaitable is left
+            this->next = nullptr;
+            this->saved = std::exchange(listener, router_type{static_cast<node_type *>(this)});
+        }
+    }
+
+    void unlink() {
+        auto *router = elem.template handler<error_event>().template target<router_type>();
+        auto **curr = router ? &router->head : nullptr;
+
+        for(; curr && *curr && *curr != static_cast<node_type *>(this); curr = &(*curr)->next) {}
+
+        if(curr && *curr) {
+            *curr = this->next;
+
+            if(!router->head) {
+                elem.template on<error_event>(std::move(this->saved));
+            } else if(this->saved) {
+                router->head->saved = std::move(this->saved);
+            }
+        }
+    }
+
+    void complete(Type &event) {
+        settle(std::move(event));
+        unlink();
+
+        // the frame (and this object with it) may be gone once resumed
+        if(!this->starting) {
+            this->coroutine.resume();
+        }
+    }
+
+public:
+    /**
+     * @brief Constructs an awaitable.
+     * @param ref The emitter that publishes the event.
+     * @param func The function that starts the operation.
+     */
+    event_awaiter(Elem &ref, Func func)
+        : node_type{&reject, nullptr, {}, {}, false},
+          elem{ref},
+          start{std::move(func)},
+          previous{},
+          value{} {}
+
+    /*! @cond TURN_OFF_DOXYGEN */
+    [[nodiscard]] bool await_ready() const noexcept {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> hndl) {
+        this->coroutine = hndl;
+        this->starting = true;
+
+        previous = std::exchange(elem.template handler<Type>(), [this](Type &event, Elem &) { complete(event); });
+        link();
+
+        if constexpr(std::is_void_v<return_type>) {
+            std::invoke(start, elem);
+        } else if(auto err = std::invoke(start, elem); err != 0 && value.index() == 0u) {
+            unlink();
+            settle(error_event{err});
+        }
+
+        this->starting = false;
+
+        return (value.index() == 0u);
+    }
+
+    await_result<Type> await_resume() {
+        if(auto *event = std::get_if<Type>(&value); event) {
+            return await_result<Type>{std::move(*event)};
+        }
+
+        return await_result<Type>{*std::get_if<error_event>(&value)};
+    }
+    /*! @endcond */
+
+private:
+    Elem &elem;
+    Func start;
+    typename Elem::template listener_t<Type> previous;
+    std::variant<std::monostate, Type, error_event> value;
+};
+
+/**
+ * @brief Makes an operation awaitable.
+ *
+ * The function is invoked with the emitter as an argument and returns either
+ * nothing or the underlying return value of the operation. As an example:
+ *
+ * @code{.cpp}
+ * auto res = co_await uvw::awaitable<uvw::connect_event>(*tcp, [&addr](auto &hndl) { return hndl.connect(addr); });
+ * @endcode
+ *
+ * The emitter must outlive the awaitable. Keep requests alive while awaiting
+ * them, as well as while accessing events that refer to their memory.
+ *
+ * @note
+ * The coroutine support is available only when compiling with C++20 or later.
+ *
+ * @tparam Type Type of the event emitted on completion.
+ * @tparam Elem Type of the emitter.
+ * @tparam Func Type of the function that starts the operation.
+ * @param elem The emitter that publishes the event.
+ * @param func The function that starts the operation.
+ * @return An awaitable for the given event type.
+ */
+template<typename Type, typename Elem, typename Func>
+[[nodiscard]] event_awaiter<Type, Elem, Func> awaitable(Elem &elem, Func func) {
+    return event_awaiter<Type, Elem, Func>{elem, std::move(func)};
+}
+
+} // namespace uvw
+
+#endif
+
+#endif // UVW_COROUTINE_INCLUDE_H
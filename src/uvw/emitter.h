@@ -3,14 +3,15 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <functional>
 #include <list>
 #include <memory>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <uv.h>
 #include "config.h"
+#include "small_function.hpp"
 #include "type_info.hpp"
 
 namespace uvw {
@@ -73,6 +74,37 @@ private:
     int ec;
 };
 
+/**
+ * @brief Compile-time handler tag.
+ *
+ * Functions that accept it (as an example, `stream_handle::read`) bind the
+ * given type to the events they emit. The static member function
+ * `Handler::on(Event &, Elem &)` is invoked directly and can be inlined,
+ * without going through the listeners registered with the emitter. Events for
+ * which `Handler` doesn't offer an overload are published as usual.
+ *
+ * Use it as `handle->read(uvw::static_handler<my_handler>{})`.
+ *
+ * @tparam Handler A type that offers static `on` member functions.
+ */
+template<typename Handler>
+struct static_handler {};
+
+namespace details {
+
+template<typename Handler, typename Type, typename Elem, typename = void>
+struct has_static_listener: std::false_type {};
+
+template<typename Handler, typename Type, typename Elem>
+struct has_static_listener<Handler, Type, Elem, std::void_t<decltype(Handler::on(std::declval<Type &>(), std::declval<Elem &>()))>>: std::true_type {};
+
+} // namespace details
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+template<typename, typename, typename>
+class event_awaiter;
+#endif
+
 /**
  * @brief Event emitter base class.
  *
@@ -81,9 +113,14 @@ private:
  */
 template<typename Elem, typename... Event>
 class emitter {
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+    template<typename, typename, typename>
+    friend class event_awaiter;
+#endif
+
 public:
     template<typename Type>
-    using listener_t = std::function<void(Type &, Elem &)>;
+    using listener_t = small_function<void(Type &, Elem &)>;
 
 private:
     template<typename Type>
@@ -104,6 +141,15 @@ protected:
         }
     }
 
+    template<typename Handler, typename Type>
+    void dispatch(Type event) {
+        if constexpr(details::has_static_listener<Handler, Type, Elem>::value) {
+            Handler::on(event, *static_cast<Elem *>(this));
+        } else {
+            publish(std::move(event));
+        }
+    }
+
 public:
     virtual ~emitter() noexcept {
         static_assert(std::is_base_of_v<emitter<Elem, Event...>, Elem>);
@@ -114,8 +160,10 @@ public:
      *
      * This method is used to register a listener with the emitter.<br/>
      * A listener is usually defined as a callable object assignable to a
-     * `std::function<void(const Event &, Elem &)`, where `Event` is the type of
-     * the event and `Elem` is the type of the resource.
+     * `small_function<void(Event &, Elem &)>`, where `Event` is the type of the
+     * event and `Elem` is the type of the resource.<br/>
+     * Listeners that fit the inline storage of `small_function` are registered
+     * without allocations.
      *
      * @param f A valid listener to be registered.
      */
@@ -0,0 +1,2 @@
+#include "file_stream.h"
+#include "file_stream.ipp"
@@ -0,0 +1,358 @@
+#ifndef UVW_FILE_STREAM_INCLUDE_H
+#define UVW_FILE_STREAM_INCLUDE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <utility>
+#include <uv.h>
+#include "config.h"
+#include "emitter.h"
+#include "fs.h"
+#include "loop.h"
+#include "request.hpp"
+#include "util.h"
+
+namespace uvw {
+
+/*! @brief File chunk event. */
+struct file_chunk_event {
+    std::unique_ptr<char[], aligned_deleter> data; /*!< A chunk of data read from the file. */
+    std::size_t length;                            /*!< The amount of data read from the file. */
+    int64_t offset;                                /*!< The offset of the chunk within the file. */
+};
+
+/*! @brief File drain event, all the pending writes have been completed. */
+struct file_drain_event {};
+
+/*! @brief File end event, no more events are emitted. */
+struct file_end_event {};
+
+namespace details {
+
+class file_chunk_req final: public request<file_chunk_req, uv_fs_t, fs_event> {
+    static void fs_chunk_callback(uv_fs_t *req);
+
+public:
+    using aligned_buffer = std::unique_ptr<char[], aligned_deleter>;
+
+    file_chunk_req(loop::token token, std::shared_ptr<loop> parent, aligned_buffer dt = {}, unsigned int len = {});
+
+    ~file_chunk_req() noexcept override;
+
+    int read(uv_file file, int64_t offset);
+    int write(uv_file file, int64_t offset);
+    int datasync(uv_file file);
+
+    unsigned int consume(std::size_t len) noexcept;
+    aligned_buffer release() noexcept;
+
+private:
+    aligned_buffer data;
+    uv_buf_t buf;
+};
+
+} // namespace details
+
+/**
+ * @brief The file read stream.
+ *
+ * It reads a file sequentially and emits its content in chunks.<br/>
+ * Up to a given number of reads are kept in flight at consecutive offsets
+ * (_read-ahead_), so that the threadpool and the device are never idle.
+ * Chunks are emitted in order on the loop thread, no matter the order in
+ * which the reads complete.
+ *
+ * The stream doesn't take the ownership of the file. It must be opened before
+ * starting the stream and must stay open until the end event has been
+ * emitted.<br/>
+ * Buffers are aligned and lengths are multiples of the chunk size, therefore
+ * files opened with `file_req::file_open_flags::DIRECT` are supported as long
+ * as the chunk size and the alignment suit the underlying device.
+ *
+ * Errors are reported through error events. The stream stops in this case.
+ *
+ * Like handles, a stream keeps itself alive until the end event has been
+ * emitted.
+ *
+ * To create a `file_read_stream` through a `loop`, no arguments are required.
+ */
+class file_read_stream final: public emitter<file_read_stream, file_chunk_event, file_end_event>, public std::enable_shared_from_this<file_read_stream> {
+    using aligned_buffer = details::file_chunk_req::aligned_buffer;
+
+    int pump();
+    void flush();
+    void complete(int64_t offset, aligned_buffer buf, std::size_t len);
+    void fail(int err);
+    void advance();
+
+public:
+    /*! @brief Default size of the chunks. */
+    static constexpr std::size_t DEFAULT_CHUNK = 1u << 17u;
+
+    explicit file_read_stream(loop::token token, std::shared_ptr<loop> ref);
+
+    file_read_stream(const file_read_stream &) = delete;
+    file_read_stream(file_read_stream &&) = delete;
+
+    file_read_stream &operator=(const file_read_stream &) = delete;
+    file_read_stream &operator=(file_read_stream &&) = delete;
+
+    /**
+     * @brief Gets the loop from which the stream was originated.
+     * @return A reference to a loop instance.
+     */
+    [[nodiscard]] loop &parent() const noexcept;
+
+    /**
+     * @brief Sets the size of the chunks read at once.
+     *
+     * The default value is 128 KiB.
+     *
+     * @param value The size of the chunks.
+     */
+    void chunk(std::size_t value) noexcept;
+
+    /**
+     * @brief Sets the maximum number of chunks read ahead.
+     *
+     * It counts both the reads in flight and the chunks waiting to be
+     * emitted. The default value is 4, that is the default size of the
+     * threadpool.
+     *
+     * @param value The maximum number of chunks read ahead.
+     */
+    void depth(std::size_t value) noexcept;
+
+    /**
+     * @brief Sets the alignment of the buffers.
+     *
+     * The default value is `file_req::DIRECT_ALIGNMENT`.
+     *
+     * @param value The alignment of the buffers, it must be a power of two.
+     */
+    void alignment(std::size_t value) noexcept;
+
+    /**
+     * @brief Starts reading a file.
+     *
+     * File chunk events are emitted as data are read, a file end event is
+     * emitted once the end of the file has been reached.
+     *
+     * @param file A valid file handle, open for reading.
+     * @param offset The offset from which to start reading.
+     * @return Underlying return value.
+     */
+    int start(file_handle file, int64_t offset = {});
+
+    /**
+     * @brief Stops emitting events.
+     *
+     * Useful to apply backpressure, reads in flight complete but the data are
+     * kept until the stream is resumed. No more than the given depth of chunks
+     * is ever buffered.
+     */
+    void pause() noexcept;
+
+    /*! @brief Resumes a paused stream. */
+    void resume();
+
+    /**
+     * @brief Stops the stream.
+     *
+     * No more file chunk events are emitted. A file end event is emitted as
+     * soon as the reads in flight complete.
+     */
+    void stop();
+
+    /**
+     * @brief Checks if the stream is reading a file.
+     * @return True if the stream is reading a file, false otherwise.
+     */
+    [[nodiscard]] bool active() const noexcept;
+
+private:
+    std::shared_ptr<loop> owner;
+    std::shared_ptr<file_read_stream> self;
+    std::map<int64_t, std::pair<aligned_buffer, std::size_t>> ready;
+    uv_file file;
+    int64_t next;
+    int64_t expected;
+    int64_t eof;
+    std::size_t length;
+    std::size_t limit;
+    std::size_t align;
+    std::size_t inflight;
+    bool paused;
+    bool stopping;
+};
+
+/**
+ * @brief The file write stream.
+ *
+ * It writes a file sequentially.<br/>
+ * Data are copied in aligned chunks and small writes are coalesced, a chunk is
+ * written as soon as it's full (_write-behind_). Up to a given number of
+ * writes are kept in flight at consecutive offsets, chunks that don't fit are
+ * queued. Optionally, data are flushed to the device with a `datasync` every
+ * given number of bytes.
+ *
+ * The stream doesn't take the ownership of the file. It must be opened before
+ * starting the stream and must stay open until the end event has been emitted.
+ * Files opened with `file_req::file_open_flags::APPEND` aren't supported,
+ * since writes complete out of order. Files opened with
+ * `file_req::file_open_flags::DIRECT` are supported as long as all the chunks
+ * written are full, the last one included.
+ *
+ * Errors are reported through error events. Data not yet written are
+ * discarded in this case and the stream ends.
+ *
+ * Like handles, a stream keeps itself alive until the end event has been
+ * emitted.
+ *
+ * To create a `file_write_stream` through a `loop`, no arguments are required.
+ */
+class file_write_stream final: public emitter<file_write_stream, file_drain_event, file_end_event>, public std::enable_shared_from_this<file_write_stream> {
+    using aligned_buffer = details::file_chunk_req::aligned_buffer;
+
+    void seal();
+    void pump();
+    void sync();
+    void complete(std::size_t len);
+    void fail(int err);
+    void advance();
+
+public:
+    /*! @brief Default size of the chunks. */
+    static constexpr std::size_t DEFAULT_CHUNK = 1u << 17u;
+
+    explicit file_write_stream(loop::token token, std::shared_ptr<loop> ref);
+
+    file_write_stream(const file_write_stream &) = delete;
+    file_write_stream(file_write_stream &&) = delete;
+
+    file_write_stream &operator=(const file_write_stream &) = delete;
+    file_write_stream &operator=(file_write_stream &&) = delete;
+
+    /**
+     * @brief Gets the loop from which the stream was originated.
+     * @return A reference to a loop instance.
+     */
+    [[nodiscard]] loop &parent() const noexcept;
+
+    /**
+     * @brief Sets the size of the chunks written at once.
+     *
+     * The default value is 128 KiB. It cannot be changed while the stream is
+     * active.
+     *
+     * @param value The size of the chunks.
+     */
+    void chunk(std::size_t value) noexcept;
+
+    /**
+     * @brief Sets the maximum number of writes in flight.
+     *
+     * The default value is 4, that is the default size of the threadpool.
+     *
+     * @param value The maximum number of writes in flight.
+     */
+    void depth(std::size_t value) noexcept;
+
+    /**
+     * @brief Sets the alignment of the buffers.
+     *
+     * The default value is `file_req::DIRECT_ALIGNMENT`.
+     *
+     * @param value The alignment of the buffers, it must be a power of two.
+     */
+    void alignment(std::size_t value) noexcept;
+
+    /**
+     * @brief Sets how often data are flushed to the device.
+     *
+     * A `datasync` is issued every given number of bytes written and once
+     * more before the end event, if needed. It's disabled by default.
+     *
+     * @param bytes The number of bytes between two syncs, 0 to disable them.
+     */
+    void sync_every(std::size_t bytes) noexcept;
+
+    /**
+     * @brief Starts writing a file.
+     * @param file A valid file handle, open for writing.
+     * @param offset The offset from which to start writing.
+     * @return Underlying return value.
+     */
+    int start(file_handle file, int64_t offset = {});
+
+    /**
+     * @brief Writes data to the file.
+     *
+     * Data are copied, the buffer can be released as soon as the function
+     * returns.<br/>
+     * A file drain event is emitted when all the full chunks have been
+     * written. Data that don't fill a chunk are written on flush or end.
+     *
+     * @param data The data to be written.
+     * @param len The length of the submitted data.
+     * @return Underlying return value.
+     */
+    int write(const char *data, std::size_t len);
+
+    /*! @brief Writes the data buffered in the current chunk, if any. */
+    void flush();
+
+    /**
+     * @brief Ends the stream.
+     *
+     * Buffered data are written and synced if required, then a file end event
+     * is emitted.
+     */
+    void end();
+
+    /**
+     * @brief Gets the amount of data queued or in flight.
+     *
+     * Useful to apply backpressure, data buffered in the current chunk aren't
+     * taken into account.
+     *
+     * @return The amount of data waiting to be written, in bytes.
+     */
+    [[nodiscard]] std::size_t queued() const noexcept;
+
+    /**
+     * @brief Checks if the stream is writing a file.
+     * @return True if the stream is writing a file, false otherwise.
+     */
+    [[nodiscard]] bool active() const noexcept;
+
+private:
+    std::shared_ptr<loop> owner;
+    std::shared_ptr<file_write_stream> self;
+    std::deque<std::pair<aligned_buffer, unsigned int>> waiting;
+    aligned_buffer current;
+    uv_file file;
+    int64_t next;
+    std::size_t fill;
+    std::size_t pending;
+    std::size_t unsynced;
+    std::size_t interval;
+    std::size_t length;
+    std::size_t limit;
+    std::size_t align;
+    std::size_t inflight;
+    bool syncing;
+    bool ending;
+    bool failed;
+};
+
+} // namespace uvw
+
+#ifndef UVW_AS_LIB
+#    include "file_stream.ipp"
+#endif
+
+#endif // UVW_FILE_STREAM_INCLUDE_H
@@ -0,0 +1,430 @@
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include "config.h"
+
+namespace uvw {
+
+namespace details {
+
+UVW_INLINE void file_chunk_req::fs_chunk_callback(uv_fs_t *req) {
+    if(auto ptr = reserve(req); req->result < 0) {
+        ptr->publish(error_event{req->result});
+    } else {
+        ptr->publish(fs_event{*req});
+    }
+}
+
+UVW_INLINE file_chunk_req::file_chunk_req(loop::token token, std::shared_ptr<loop> parent, aligned_buffer dt, unsigned int len)
+    : request{token, std::move(parent)},
+      data{std::move(dt)},
+      buf{uv_buf_init(data.get(), len)} {}
+
+UVW_INLINE file_chunk_req::~file_chunk_req() noexcept {
+    uv_fs_req_cleanup(raw());
+}
+
+UVW_INLINE int file_chunk_req::read(uv_file file, int64_t offset) {
+    uv_fs_req_cleanup(raw());
+    return leak_if(uv_fs_read(parent().raw(), raw(), file, &buf, 1, offset, &fs_chunk_callback));
+}
+
+UVW_INLINE int file_chunk_req::write(uv_file file, int64_t offset) {
+    uv_fs_req_cleanup(raw());
+    return leak_if(uv_fs_write(parent().raw(), raw(), file, &buf, 1, offset, &fs_chunk_callback));
+}
+
+UVW_INLINE int file_chunk_req::datasync(uv_file file) {
+    uv_fs_req_cleanup(raw());
+    return leak_if(uv_fs_fdatasync(parent().raw(), raw(), file, &fs_chunk_callback));
+}
+
+UVW_INLINE unsigned int file_chunk_req::consume(std::size_t len) noexcept {
+    const auto count = std::min<std::size_t>(len, buf.len);
+    buf.base += count;
+    buf.len -= static_cast<decltype(buf.len)>(count);
+    return static_cast<unsigned int>(buf.len);
+}
+
+UVW_INLINE file_chunk_req::aligned_buffer file_chunk_req::release() noexcept {
+    buf = uv_buf_init(nullptr, 0u);
+    return std::move(data);
+}
+
+} // namespace details
+
+UVW_INLINE int file_read_stream::pump() {
+    while(self && !stopping && next < eof && (inflight + ready.size()) < limit) {
+        auto buf = file_req::make_aligned(length, align);
+
+        if(!buf) {
+            return UV_ENOMEM;
+        }
+
+        auto req = owner->resource<details::file_chunk_req>(std::move(buf), static_cast<unsigned int>(length));
+
+        req->on<fs_event>([this, offset = next](const fs_event &event, details::file_chunk_req &curr) {
+            complete(offset, curr.release(), event.result);
+        });
+
+        req->on<error_event>([this](const error_event &event, details::file_chunk_req &) {
+            --inflight;
+            fail(event.code());
+            advance();
+        });
+
+        if(auto err = req->read(file, next); err != 0) {
+            return err;
+        }
+
+        next += static_cast<int64_t>(length);
+        ++inflight;
+    }
+
+    return 0;
+}
+
+UVW_INLINE void file_read_stream::flush() {
+    while(!paused && !stopping && !ready.empty() && ready.begin()->first == expected) {
+        auto elem = ready.extract(ready.begin());
+        auto &[buf, len] = elem.mapped();
+        expected += static_cast<int64_t>(len);
+        publish(file_chunk_event{std::move(buf), len, elem.key()});
+    }
+}
+
+UVW_INLINE void file_read_stream::complete(int64_t offset, aligned_buffer buf, std::size_t len) {
+    --inflight;
+
+    if(!stopping) {
+        // a short read marks the end of the file, data read past it (if any) are discarded
+        if(len < length) {
+            eof = std::min(eof, offset + static_cast<int64_t>(len));
+            ready.erase(ready.lower_bound(eof), ready.end());
+        }
+
+        if(len != 0u && offset < eof) {
+            ready.emplace(offset, std::make_pair(std::move(buf), len));
+        }
+    }
+
+    advance();
+}
+
+UVW_INLINE void file_read_stream::fail(int err) {
+    if(!stopping) {
+        stopping = true;
+        ready.clear();
+        publish(error_event{err});
+    }
+}
+
+UVW_INLINE void file_read_stream::advance() {
+    flush();
+
+    if(auto err = pump(); err != 0) {
+        fail(err);
+    }
+
+    if(self && !inflight && (stopping || (expected >= eof && ready.empty()))) {
+        [[maybe_unused]] auto ptr = std::move(self);
+        publish(file_end_event{});
+    }
+}
+
+UVW_INLINE file_read_stream::file_read_stream(loop::token, std::shared_ptr<loop> ref)
+    : owner{std::move(ref)},
+      self{},
+      ready{},
+      file{-1},
+      next{},
+      expected{},
+      eof{},
+      length{DEFAULT_CHUNK},
+      limit{4u},
+      align{file_req::DIRECT_ALIGNMENT},
+      inflight{},
+      paused{},
+      stopping{} {}
+
+UVW_INLINE loop &file_read_stream::parent() const noexcept {
+    return *owner;
+}
+
+UVW_INLINE void file_read_stream::chunk(std::size_t value) noexcept {
+    if(!self) {
+        length = std::clamp<std::size_t>(value, 1u, std::numeric_limits<unsigned int>::max());
+    }
+}
+
+UVW_INLINE void file_read_stream::depth(std::size_t value) noexcept {
+    limit = value ? value : 1u;
+}
+
+UVW_INLINE void file_read_stream::alignment(std::size_t value) noexcept {
+    align = value;
+}
+
+UVW_INLINE int file_read_stream::start(file_handle fd, int64_t offset) {
+    if(self) {
+        return UV_EBUSY;
+    }
+
+    file = fd;
+    next = expected = offset;
+    eof = std::numeric_limits<int64_t>::max();
+    paused = stopping = false;
+    self = shared_from_this();
+
+    if(auto err = pump(); err != 0) {
+        if(!inflight) {
+            self.reset();
+            return err;
+        }
+
+        fail(err);
+    }
+
+    return 0;
+}
+
+UVW_INLINE void file_read_stream::pause() noexcept {
+    paused = true;
+}
+
+UVW_INLINE void file_read_stream::resume() {
+    if(std::exchange(paused, false)) {
+        advance();
+    }
+}
+
+UVW_INLINE void file_read_stream::stop() {
+    if(self && !stopping) {
+        stopping = true;
+        ready.clear();
+        advance();
+    }
+}
+
+UVW_INLINE bool file_read_stream::active() const noexcept {
+    return static_cast<bool>(self);
+}
+
+UVW_INLINE void file_write_stream::seal() {
+    if(fill != 0u) {
+        pending += fill;
+        waiting.emplace_back(std::move(current), static_cast<unsigned int>(std::exchange(fill, 0u)));
+    }
+}
+
+UVW_INLINE void file_write_stream::pump() {
+    while(!failed && inflight < limit && !waiting.empty()) {
+        auto [buf, len] = std::move(waiting.front());
+        waiting.pop_front();
+
+        auto req = owner->resource<details::file_chunk_req>(std::move(buf), len);
+
+        req->on<fs_event>([this, offset = next, len = len](const fs_event &event, details::file_chunk_req &curr) {
+            if(const auto left = curr.consume(event.result); left != 0u && !failed) {
+                // short writes are resumed where they stopped, no progress at all is an error
+                if(auto err = event.result ? curr.write(file, offset + static_cast<int64_t>(len - left)) : UV_EIO; err != 0) {
+                    --inflight;
+                    fail(err);
+                    advance();
+                }
+            } else {
+                complete(len);
+            }
+        });
+
+        req->on<error_event>([this](const error_event &event, details::file_chunk_req &) {
+            --inflight;
+            fail(event.code());
+            advance();
+        });
+
+        if(auto err = req->write(file, next); err != 0) {
+            fail(err);
+        } else {
+            next += static_cast<int64_t>(len);
+            ++inflight;
+        }
+    }
+}
+
+UVW_INLINE void file_write_stream::sync() {
+    if(!syncing && !failed) {
+        auto req = owner->resource<details::file_chunk_req>();
+
+        req->on<fs_event>([this](const fs_event &, details::file_chunk_req &) {
+            syncing = false;
+            advance();
+        });
+
+        req->on<error_event>([this](const error_event &event, details::file_chunk_req &) {
+            syncing = false;
+            fail(event.code());
+            advance();
+        });
+
+        if(auto err = req->datasync(file); err != 0) {
+            fail(err);
+        } else {
+            syncing = true;
+            unsynced = 0u;
+        }
+    }
+}
+
+UVW_INLINE void file_write_stream::complete(std::size_t len) {
+    --inflight;
+
+    if(!failed) {
+        pending -= len;
+        unsynced += len;
+
+        if(interval && unsynced >= interval) {
+            sync();
+        }
+
+        if(!pending && !ending) {
+            publish(file_drain_event{});
+        }
+    }
+
+    advance();
+}
+
+UVW_INLINE void file_write_stream::fail(int err) {
+    if(!failed) {
+        failed = true;
+        waiting.clear();
+        current.reset();
+        fill = pending = 0u;
+        publish(error_event{err});
+    }
+}
+
+UVW_INLINE void file_write_stream::advance() {
+    pump();
+
+    if(self && !inflight && !syncing && (failed || (ending && waiting.empty()))) {
+        if(!failed && interval && unsynced) {
+            sync();
+        }
+
+        if(!syncing) {
+            [[maybe_unused]] auto ptr = std::move(self);
+            publish(file_end_event{});
+        }
+    }
+}
+
+UVW_INLINE file_write_stream::file_write_stream(loop::token, std::shared_ptr<loop> ref)
+    : owner{std::move(ref)},
+      self{},
+      waiting{},
+      current{},
+      file{-1},
+      next{},
+      fill{},
+      pending{},
+      unsynced{},
+      interval{},
+      length{DEFAULT_CHUNK},
+      limit{4u},
+      align{file_req::DIRECT_ALIGNMENT},
+      inflight{},
+      syncing{},
+      ending{},
+      failed{} {}
+
+UVW_INLINE loop &file_write_stream::parent() const noexcept {
+    return *owner;
+}
+
+UVW_INLINE void file_write_stream::chunk(std::size_t value) noexcept {
+    if(!self) {
+        length = std::clamp<std::size_t>(value, 1u, std::numeric_limits<unsigned int>::max());
+    }
+}
+
+UVW_INLINE void file_write_stream::depth(std::size_t value) noexcept {
+    limit = value ? value : 1u;
+}
+
+UVW_INLINE void file_write_stream::alignment(std::size_t value) noexcept {
+    if(!self) {
+        align = value;
+    }
+}
+
+UVW_INLINE void file_write_stream::sync_every(std::size_t bytes) noexcept {
+    interval = bytes;
+}
+
+UVW_INLINE int file_write_stream::start(file_handle fd, int64_t offset) {
+    if(self) {
+        return UV_EBUSY;
+    }
+
+    file = fd;
+    next = offset;
+    fill = pending = unsynced = 0u;
+    syncing = ending = failed = false;
+    self = shared_from_this();
+
+    return 0;
+}
+
+UVW_INLINE int file_write_stream::write(const char *data, std::size_t len) {
+    if(!self || ending || failed) {
+        return UV_EINVAL;
+    }
+
+    while(len != 0u) {
+        if(!current && !(current = file_req::make_aligned(length, align))) {
+            return UV_ENOMEM;
+        }
+
+        const auto count = std::min(len, length - fill);
+        std::memcpy(current.get() + fill, data, count);
+        fill += count;
+        data += count;
+        len -= count;
+
+        if(fill == length) {
+            seal();
+        }
+    }
+
+    pump();
+
+    return 0;
+}
+
+UVW_INLINE void file_write_stream::flush() {
+    if(self && !failed) {
+        seal();
+        advance();
+    }
+}
+
+UVW_INLINE void file_write_stream::end() {
+    if(self && !ending) {
+        ending = true;
+        seal();
+        advance();
+    }
+}
+
+UVW_INLINE std::size_t file_write_stream::queued() const noexcept {
+    return pending;
+}
+
+UVW_INLINE bool file_write_stream::active() const noexcept {
+    return static_cast<bool>(self);
+}
+
+} // namespace uvw
@@ -5,6 +5,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 #include <uv.h>
 #include "config.h"
 #include "enum.hpp"
@@ -183,6 +184,8 @@ struct fs_event {
             dirent.name = static_cast<uv_dir_t *>(req.ptr)->dirents[0].name;
             dirent.type = static_cast<entry_type>(static_cast<uv_dir_t *>(req.ptr)->dirents[0].type);
             dirent.eos = !req.result;
+            entries.data = static_cast<uv_dir_t *>(req.ptr)->dirents;
+            entries.length = result;
             break;
         case fs_type::STATFS:
             statfs = *static_cast<fs_info *>(req.ptr);
@@ -213,6 +216,26 @@ struct fs_event {
         entry_type type;  /*!< The entry type. */
         bool eos;         /*!< True if there a no more entries to read. */
     } dirent;
+
+    struct {
+        const uv_dirent_t *data{}; /*!< The entries read at once, if any. */
+        std::size_t length{};      /*!< The number of entries, 0 if there a no more entries to read. */
+    } entries;
+};
+
+/**
+ * @brief Deleter for buffers allocated with a given alignment.
+ *
+ * See `file_req::make_aligned` for further details.
+ */
+struct aligned_deleter {
+    /**
+     * @brief Releases an aligned buffer.
+     * @param ptr A buffer allocated with the alignment of the deleter.
+     */
+    void operator()(char *ptr) const noexcept;
+
+    std::size_t alignment{}; /*!< The alignment of the buffer. */
 };
 
 /**
@@ -260,9 +283,28 @@ class file_req final: public fs_request<file_req> {
 
 public:
     using file_open_flags = details::uvw_file_open_flags;
+    using aligned_buffer = std::unique_ptr<char[], aligned_deleter>;
+
+    /*! @brief Default alignment of buffers, suitable for direct I/O. */
+    static constexpr std::size_t DIRECT_ALIGNMENT = 4096u;
 
     using fs_request::fs_request;
 
+    /**
+     * @brief Allocates a buffer with a given alignment.
+     *
+     * Files opened with `file_open_flags::DIRECT` require buffers aligned to
+     * the logical block size of the underlying device (offsets and lengths
+     * are usually subject to the same constraint). Aligned buffers are meant
+     * to be allocated once and reused with `read` and `write` functions that
+     * don't take the ownership of the data.
+     *
+     * @param len The size of the buffer.
+     * @param alignment The alignment of the buffer, it must be a power of two.
+     * @return A valid buffer in case of success, an empty one otherwise.
+     */
+    [[nodiscard]] static aligned_buffer make_aligned(std::size_t len, std::size_t alignment = DIRECT_ALIGNMENT) noexcept;
+
     ~file_req() noexcept override;
 
     /**
@@ -381,6 +423,39 @@ public:
      */
     std::pair<bool, std::pair<std::unique_ptr<const char[]>, std::size_t>> read_sync(int64_t offset, unsigned int len);
 
+    /**
+     * @brief Async [read](http://linux.die.net/man/2/preadv) into a
+     * caller-supplied buffer.
+     *
+     * The request doesn't take the ownership of the buffer. Be sure that its
+     * lifetime overcome the one of the request.<br/>
+     * No memory is allocated, therefore a buffer can be reused for subsequent
+     * reads to stream a file.
+     *
+     * Emit a `fs_event` event when completed. The `read` member of the event
+     * doesn't carry any data in this case, the amount of data read is stored
+     * in the `result` member.
+     *
+     * @param buf The buffer to fill.
+     * @param len The length of the buffer.
+     * @param offset Offset, as described in the official documentation.
+     */
+    void read(char *buf, unsigned int len, int64_t offset);
+
+    /**
+     * @brief Sync [read](http://linux.die.net/man/2/preadv) into a
+     * caller-supplied buffer.
+     *
+     * @param buf The buffer to fill.
+     * @param len The length of the buffer.
+     * @param offset Offset, as described in the official documentation.
+     *
+     * @return A `std::pair` composed as it follows:
+     * * A boolean value that is true in case of success, false otherwise.
+     * * The amount of data read from the given path.
+     */
+    std::pair<bool, std::size_t> read_sync(char *buf, unsigned int len, int64_t offset);
+
     /**
      * @brief Async [write](http://linux.die.net/man/2/pwritev).
      *
@@ -422,6 +497,95 @@ public:
      */
     std::pair<bool, std::size_t> write_sync(std::unique_ptr<char[]> buf, unsigned int len, int64_t offset);
 
+    /**
+     * @brief Async [read](http://linux.die.net/man/2/preadv) into multiple
+     * buffers at once.
+     *
+     * The request doesn't take the ownership of the buffers. Be sure that their
+     * lifetime overcome the one of the request. The array of buffers itself can
+     * be discarded once the function returns.
+     *
+     * Emit a `fs_event` event when completed. The `read` member of the event
+     * doesn't carry any data in this case, buffers are filled in order.
+     *
+     * @param bufs The buffers to fill.
+     * @param nbufs The number of buffers.
+     * @param offset Offset, as described in the official documentation.
+     */
+    void read(const uv_buf_t bufs[], unsigned int nbufs, int64_t offset);
+
+    /**
+     * @brief Sync [read](http://linux.die.net/man/2/preadv) into multiple
+     * buffers at once.
+     *
+     * @param bufs The buffers to fill.
+     * @param nbufs The number of buffers.
+     * @param offset Offset, as described in the official documentation.
+     *
+     * @return A `std::pair` composed as it follows:
+     * * A boolean value that is true in case of success, false otherwise.
+     * * The amount of data read from the given path.
+     */
+    std::pair<bool, std::size_t> read_sync(const uv_buf_t bufs[], unsigned int nbufs, int64_t offset);
+
+    /**
+     * @brief Async [write](http://linux.die.net/man/2/pwritev) of multiple
+     * buffers at once.
+     *
+     * Buffers are written in order by means of a single request. The request
+     * takes the ownership of the data and it is in charge of delete them.
+     *
+     * Emit a `fs_event` event when completed.
+     *
+     * @param data The buffers to be written, each one along with its length.
+     * @param offset Offset, as described in the official documentation.
+     */
+    void write(std::vector<std::pair<std::unique_ptr<char[]>, unsigned int>> data, int64_t offset);
+
+    /**
+     * @brief Async [write](http://linux.die.net/man/2/pwritev) of multiple
+     * buffers at once.
+     *
+     * Buffers are written in order by means of a single request. The request
+     * doesn't take the ownership of the data. Be sure that their lifetime
+     * overcome the one of the request. The array of buffers itself can be
+     * discarded once the function returns.
+     *
+     * Emit a `fs_event` event when completed.
+     *
+     * @param bufs The buffers to be written.
+     * @param nbufs The number of buffers.
+     * @param offset Offset, as described in the official documentation.
+     */
+    void write(const uv_buf_t bufs[], unsigned int nbufs, int64_t offset);
+
+    /**
+     * @brief Sync [write](http://linux.die.net/man/2/pwritev) of multiple
+     * buffers at once.
+     *
+     * @param data The buffers to be written, each one along with its length.
+     * @param offset Offset, as described in the official documentation.
+     *
+     * @return A `std::pair` composed as it follows:
+     * * A boolean value that is true in case of success, false otherwise.
+     * * The amount of data written to the given path.
+     */
+    std::pair<bool, std::size_t> write_sync(std::vector<std::pair<std::unique_ptr<char[]>, unsigned int>> data, int64_t offset);
+
+    /**
+     * @brief Sync [write](http://linux.die.net/man/2/pwritev) of multiple
+     * buffers at once.
+     *
+     * @param bufs The buffers to be written.
+     * @param nbufs The number of buffers.
+     * @param offset Offset, as described in the official documentation.
+     *
+     * @return A `std::pair` composed as it follows:
+     * * A boolean value that is true in case of success, false otherwise.
+     * * The amount of data written to the given path.
+     */
+    std::pair<bool, std::size_t> write_sync(const uv_buf_t bufs[], unsigned int nbufs, int64_t offset);
+
     /**
      * @brief Async [fstat](http://linux.die.net/man/2/fstat).
      *
@@ -571,7 +735,10 @@ public:
     operator file_handle() const noexcept;
 
 private:
+    std::vector<uv_buf_t> own(std::vector<std::pair<std::unique_ptr<char[]>, unsigned int>> data);
+
     std::unique_ptr<char[]> current{nullptr};
+    std::vector<std::pair<std::unique_ptr<char[]>, unsigned int>> chunks{};
     uv_buf_t buffer{};
     uv_file file{BAD_FD};
 };
@@ -1195,8 +1362,49 @@ public:
      */
     std::pair<bool, std::pair<entry_type, const char *>> readdir_sync();
 
+    /**
+     * @brief Iterates asynchronously over a directory stream up to `count`
+     * entries at a time.
+     *
+     * Emit a `fs_event` event when completed. Entries are available through
+     * the `entries` member of the event and are valid until the next request
+     * is made with this object.<br/>
+     * The storage for the entries is owned by the request and reused across
+     * invocations.
+     *
+     * This function isn't thread safe. Moreover, it doesn't return the `.` and
+     * `..` entries.
+     *
+     * @param count The maximum number of entries to read at once.
+     */
+    void readdir(std::size_t count);
+
+    /**
+     * @brief Iterates synchronously over a directory stream up to `count`
+     * entries at a time.
+     *
+     * Entries are valid until the next request is made with this object.
+     * The storage for the entries is owned by the request and reused across
+     * invocations.
+     *
+     * This function isn't thread safe. Moreover, it doesn't return the `.` and
+     * `..` entries.
+     *
+     * @param count The maximum number of entries to read at once.
+     * @return A pair where:
+     *
+     * * The first parameter is a boolean value that is true if at least an
+     * entry has been read, false otherwise.
+     * * The second parameter is a pair composed of a pointer to the entries
+     * read and their number.
+     */
+    std::pair<bool, std::pair<const uv_dirent_t *, std::size_t>> readdir_sync(std::size_t count);
+
 private:
+    uv_dir_t *prepare_readdir(std::size_t count);
+
     uv_dirent_t dirents;
+    std::vector<uv_dirent_t> batch;
 };
 
 /*! @brief Helper functions. */
@@ -1,4 +1,5 @@
 #include <array>
+#include <new>
 #include "config.h"
 
 namespace uvw {
@@ -29,6 +30,19 @@ UVW_INLINE void file_req::fs_read_callback(uv_fs_t *req) {
     }
 }
 
+UVW_INLINE void aligned_deleter::operator()(char *ptr) const noexcept {
+    ::operator delete[](ptr, std::align_val_t{alignment});
+}
+
+UVW_INLINE file_req::aligned_buffer file_req::make_aligned(std::size_t len, std::size_t alignment) noexcept {
+    if(!alignment || (alignment & (alignment - 1u))) {
+        return aligned_buffer{nullptr, aligned_deleter{alignment}};
+    }
+
+    auto *ptr = static_cast<char *>(::operator new[](len, std::align_val_t{alignment}, std::nothrow));
+    return aligned_buffer{ptr, aligned_deleter{alignment}};
+}
+
 UVW_INLINE file_req::~file_req() noexcept {
     uv_fs_req_cleanup(raw());
 }
@@ -88,6 +102,16 @@ UVW_INLINE std::pair<bool, std::pair<std::unique_ptr<const char[]>, std::size_t>
     return std::make_pair(!err, std::make_pair(std::move(current), err ? 0 : std::size_t(req->result)));
 }
 
+UVW_INLINE void file_req::read(char *buf, unsigned int len, int64_t offset) {
+    std::array bufs{uv_buf_init(buf, len)};
+    read(bufs.data(), 1, offset);
+}
+
+UVW_INLINE std::pair<bool, std::size_t> file_req::read_sync(char *buf, unsigned int len, int64_t offset) {
+    std::array bufs{uv_buf_init(buf, len)};
+    return read_sync(bufs.data(), 1, offset);
+}
+
 UVW_INLINE void file_req::write(std::unique_ptr<char[]> buf, unsigned int len, int64_t offset) {
     current = std::move(buf);
     std::array bufs{uv_buf_init(current.get(), len)};
@@ -111,6 +135,59 @@ UVW_INLINE std::pair<bool, std::size_t> file_req::write_sync(std::unique_ptr<cha
     return std::make_pair(!err, err ? 0 : std::size_t(req->result));
 }
 
+UVW_INLINE std::vector<uv_buf_t> file_req::own(std::vector<std::pair<std::unique_ptr<char[]>, unsigned int>> data) {
+    std::vector<uv_buf_t> bufs;
+    chunks = std::move(data);
+    bufs.reserve(chunks.size());
+
+    for(auto &&[chunk, len]: chunks) {
+        bufs.push_back(uv_buf_init(chunk.get(), len));
+    }
+
+    return bufs;
+}
+
+UVW_INLINE void file_req::read(const uv_buf_t bufs[], unsigned int nbufs, int64_t offset) {
+    uv_fs_req_cleanup(this->raw());
+    uv_fs_read(parent().raw(), raw(), file, bufs, nbufs, offset, &fs_request_callback);
+}
+
+UVW_INLINE std::pair<bool, std::size_t> file_req::read_sync(const uv_buf_t bufs[], unsigned int nbufs, int64_t offset) {
+    auto req = raw();
+    uv_fs_req_cleanup(this->raw());
+    uv_fs_read(parent().raw(), req, file, bufs, nbufs, offset, nullptr);
+    bool err = req->result < 0;
+    return std::make_pair(!err, err ? 0 : std::size_t(req->result));
+}
+
+UVW_INLINE void file_req::write(std::vector<std::pair<std::unique_ptr<char[]>, unsigned int>> data, int64_t offset) {
+    const auto bufs = own(std::move(data));
+    uv_fs_req_cleanup(this->raw());
+    uv_fs_write(parent().raw(), raw(), file, bufs.data(), static_cast<unsigned int>(bufs.size()), offset, &fs_request_callback);
+}
+
+UVW_INLINE void file_req::write(const uv_buf_t bufs[], unsigned int nbufs, int64_t offset) {
+    uv_fs_req_cleanup(this->raw());
+    uv_fs_write(parent().raw(), raw(), file, bufs, nbufs, offset, &fs_request_callback);
+}
+
+UVW_INLINE std::pair<bool, std::size_t> file_req::write_sync(std::vector<std::pair<std::unique_ptr<char[]>, unsigned int>> data, int64_t offset) {
+    const auto bufs = own(std::move(data));
+    auto req = raw();
+    uv_fs_req_cleanup(this->raw());
+    uv_fs_write(parent().raw(), req, file, bufs.data(), static_cast<unsigned int>(bufs.size()), offset, nullptr);
+    bool err = req->result < 0;
+    return std::make_pair(!err, err ? 0 : std::size_t(req->result));
+}
+
+UVW_INLINE std::pair<bool, std::size_t> file_req::write_sync(const uv_buf_t bufs[], unsigned int nbufs, int64_t offset) {
+    auto req = raw();
+    uv_fs_req_cleanup(this->raw());
+    uv_fs_write(parent().raw(), req, file, bufs, nbufs, offset, nullptr);
+    bool err = req->result < 0;
+    return std::make_pair(!err, err ? 0 : std::size_t(req->result));
+}
+
 UVW_INLINE void file_req::stat() {
     uv_fs_req_cleanup(this->raw());
     uv_fs_fstat(parent().raw(), raw(), file, &fs_request_callback);
@@ -523,22 +600,49 @@ UVW_INLINE bool fs_req::closedir_sync() {
 UVW_INLINE void fs_req::readdir() {
     auto req = raw();
     auto *dir = static_cast<uv_dir_t *>(req->ptr);
+    uv_fs_req_cleanup(this->raw());
     dir->dirents = &dirents;
     dir->nentries = 1;
-    uv_fs_req_cleanup(this->raw());
     uv_fs_readdir(parent().raw(), req, dir, &fs_request_callback);
 }
 
 UVW_INLINE std::pair<bool, std::pair<fs_req::entry_type, const char *>> fs_req::readdir_sync() {
     auto req = raw();
     auto *dir = static_cast<uv_dir_t *>(req->ptr);
+    uv_fs_req_cleanup(this->raw());
     dir->dirents = &dirents;
     dir->nentries = 1;
-    uv_fs_req_cleanup(this->raw());
     uv_fs_readdir(parent().raw(), req, dir, nullptr);
     return {req->result != 0, {static_cast<entry_type>(dirents.type), dirents.name}};
 }
 
+UVW_INLINE uv_dir_t *fs_req::prepare_readdir(std::size_t count) {
+    auto *dir = static_cast<uv_dir_t *>(raw()->ptr);
+    // names of the previous entries are released through the old buffer, it must be still in place
+    uv_fs_req_cleanup(this->raw());
+
+    if(batch.size() < count) {
+        batch.resize(count);
+    }
+
+    dir->dirents = batch.data();
+    dir->nentries = count;
+    return dir;
+}
+
+UVW_INLINE void fs_req::readdir(std::size_t count) {
+    auto *dir = prepare_readdir(count);
+    uv_fs_readdir(parent().raw(), raw(), dir, &fs_request_callback);
+}
+
+UVW_INLINE std::pair<bool, std::pair<const uv_dirent_t *, std::size_t>> fs_req::readdir_sync(std::size_t count) {
+    auto req = raw();
+    auto *dir = prepare_readdir(count);
+    uv_fs_readdir(parent().raw(), req, dir, nullptr);
+    const auto length = (req->result > 0) ? static_cast<std::size_t>(req->result) : std::size_t{};
+    return {length != 0u, {batch.data(), length}};
+}
+
 UVW_INLINE os_file_descriptor fs_helper::handle(file_handle file) noexcept {
     return uv_get_osfhandle(file);
 }
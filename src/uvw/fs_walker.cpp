@@ -0,0 +1,2 @@
+#include "fs_walker.h"
+#include "fs_walker.ipp"
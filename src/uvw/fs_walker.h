@@ -0,0 +1,200 @@
+#ifndef UVW_FS_WALKER_INCLUDE_H
+#define UVW_FS_WALKER_INCLUDE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include <uv.h>
+#include "config.h"
+#include "emitter.h"
+#include "fs.h"
+#include "loop.h"
+#include "util.h"
+#include "work.h"
+
+namespace uvw {
+
+/*! @brief Entry found while walking a directory tree. */
+struct fs_walk_entry {
+    std::string path;        /*!< The path of the entry, the root path followed by the relative one. */
+    fs_req::entry_type type; /*!< The entry type, symbolic links are resolved if followed. */
+    std::size_t depth;       /*!< The depth of the entry, 0 for the children of the root. */
+    file_info stat;          /*!< The status of the entry, if requested. */
+};
+
+/*! @brief Fs walk event. */
+struct fs_walk_event {
+    std::vector<fs_walk_entry> entries; /*!< A batch of entries. */
+};
+
+/*! @brief Fs walk end event, no more entries are emitted. */
+struct fs_walk_end_event {};
+
+/**
+ * @brief The fs walker.
+ *
+ * It walks a directory tree recursively and emits the entries found in
+ * batches.<br/>
+ * Directories are read on the threadpool, one work request per directory and
+ * up to a given number of directories at a time. Entries are emitted on the
+ * loop thread.
+ *
+ * Errors are reported through error events, one for each directory that cannot
+ * be read. The walk goes on with the other directories in this case.
+ *
+ * Like handles, a walker keeps itself alive until the end event has been
+ * emitted.
+ *
+ * To create a `fs_walker` through a `loop`, no arguments are required.
+ */
+class fs_walker final: public emitter<fs_walker, fs_walk_event, fs_walk_end_event>, public std::enable_shared_from_this<fs_walker> {
+    struct job {
+        std::string path;
+        std::size_t depth;
+        std::vector<std::vector<fs_walk_entry>> batches{};
+        file_info stat{};
+        bool known{};
+        int error{};
+    };
+
+    static void read(fs_req &dir, fs_req &entry, job &curr, bool follow, bool info, std::size_t count);
+
+    void pump();
+    void flush();
+    void complete(job &curr);
+    void advance();
+
+public:
+    using filter_type = std::function<bool(const fs_walk_entry &)>;
+
+    explicit fs_walker(loop::token token, std::shared_ptr<loop> ref);
+
+    fs_walker(const fs_walker &) = delete;
+    fs_walker(fs_walker &&) = delete;
+
+    fs_walker &operator=(const fs_walker &) = delete;
+    fs_walker &operator=(fs_walker &&) = delete;
+
+    /**
+     * @brief Gets the loop from which the walker was originated.
+     * @return A reference to a loop instance.
+     */
+    [[nodiscard]] loop &parent() const noexcept;
+
+    /**
+     * @brief Sets the maximum number of directories read at a time.
+     *
+     * The default value is 4, that is the default size of the threadpool.
+     *
+     * @param value The maximum number of directories read at a time.
+     */
+    void concurrency(std::size_t value) noexcept;
+
+    /**
+     * @brief Sets the maximum number of entries emitted with a single event.
+     *
+     * It's also the number of entries read at once from a directory stream.
+     * The default value is 256.
+     *
+     * @param value The maximum number of entries per event.
+     */
+    void batch(std::size_t value) noexcept;
+
+    /**
+     * @brief Enables or disables the status of the entries.
+     *
+     * When enabled, the `stat` member of the entries is filled in on the
+     * threadpool. It's disabled by default.
+     *
+     * @param value True to get the status of the entries, false otherwise.
+     */
+    void stat(bool value) noexcept;
+
+    /**
+     * @brief Follows or skips symbolic links.
+     *
+     * When enabled, symbolic links to directories are walked as well and the
+     * type and the status of the entries are those of the targets.
+     * Directories already visited are not walked twice, so that cycles are
+     * harmless. It's disabled by default.
+     *
+     * @param value True to follow symbolic links, false otherwise.
+     */
+    void follow(bool value) noexcept;
+
+    /**
+     * @brief Sets a function to prune the tree.
+     *
+     * The function is invoked on the loop thread for each entry. Entries for
+     * which it returns false aren't emitted and, if directories, aren't
+     * walked.
+     *
+     * @param func A function to prune the tree, if any.
+     */
+    void filter(filter_type func);
+
+    /**
+     * @brief Starts walking a directory tree.
+     *
+     * Fs walk events are emitted as entries are found, a fs walk end event is
+     * emitted once the whole tree has been walked.
+     *
+     * @param path The root of the tree.
+     * @return Underlying return value.
+     */
+    int start(const std::string &path);
+
+    /**
+     * @brief Stops emitting events and reading directories.
+     *
+     * Useful to apply backpressure, directories that are being read complete
+     * their reads but the entries are kept until the walker is resumed.
+     */
+    void pause() noexcept;
+
+    /*! @brief Resumes a paused walker. */
+    void resume();
+
+    /**
+     * @brief Stops the walker.
+     *
+     * No more fs walk events are emitted. A fs walk end event is emitted as
+     * soon as the directories that are being read complete their reads.
+     */
+    void stop();
+
+    /**
+     * @brief Checks if the walker is walking a tree.
+     * @return True if the walker is walking a tree, false otherwise.
+     */
+    [[nodiscard]] bool active() const noexcept;
+
+private:
+    std::shared_ptr<loop> owner;
+    std::shared_ptr<fs_walker> self;
+    filter_type predicate;
+    std::deque<std::pair<std::string, std::size_t>> pending;
+    std::deque<std::vector<fs_walk_entry>> ready;
+    std::set<std::pair<uint64_t, uint64_t>> visited;
+    std::size_t limit;
+    std::size_t count;
+    std::size_t inflight;
+    bool info;
+    bool links;
+    bool paused;
+    bool stopping;
+};
+
+} // namespace uvw
+
+#ifndef UVW_AS_LIB
+#    include "fs_walker.ipp"
+#endif
+
+#endif // UVW_FS_WALKER_INCLUDE_H
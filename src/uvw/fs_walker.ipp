@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <tuple>
+#include <utility>
+#include "config.h"
+
+namespace uvw {
+
+UVW_INLINE void fs_walker::read(fs_req &dir, fs_req &entry, job &curr, bool follow, bool info, std::size_t count) {
+    if(follow) {
+        // the identity of the directory is required to detect cycles
+        std::tie(curr.known, curr.stat) = dir.stat_sync(curr.path);
+    }
+
+    if(!dir.opendir_sync(curr.path)) {
+        curr.error = static_cast<int>(dir.raw()->result);
+        return;
+    }
+
+    const bool trailing = !curr.path.empty() && (curr.path.back() == '/' || curr.path.back() == '\\');
+    const std::string prefix = trailing ? curr.path : (curr.path + '/');
+
+    for(auto res = dir.readdir_sync(count); res.first; res = dir.readdir_sync(count)) {
+        // entries are grouped as they are read, so that batches are moved around as a whole
+        auto &entries = curr.batches.emplace_back();
+        entries.reserve(res.second.second);
+
+        for(std::size_t pos{}; pos < res.second.second; ++pos) {
+            const auto &dirent = res.second.first[pos];
+            auto &elem = entries.emplace_back(fs_walk_entry{prefix + dirent.name, static_cast<fs_req::entry_type>(dirent.type), curr.depth, {}});
+            const bool unknown = (elem.type == fs_req::entry_type::UNKNOWN);
+            const bool resolve = follow && (elem.type == fs_req::entry_type::LINK);
+
+            if(info || unknown || resolve) {
+                if(auto [ok, stat] = follow ? entry.stat_sync(elem.path) : entry.lstat_sync(elem.path); ok) {
+                    elem.stat = stat;
+
+                    if(unknown || resolve) {
+                        switch(stat.st_mode & S_IFMT) {
+                        case S_IFDIR:
+                            elem.type = fs_req::entry_type::DIR;
+                            break;
+                        case S_IFREG:
+                            elem.type = fs_req::entry_type::FILE;
+                            break;
+                        default:
+                            // nothing to do here
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    if(dir.raw()->result < 0) {
+        curr.error = static_cast<int>(dir.raw()->result);
+    }
+
+    dir.closedir_sync();
+}
+
+UVW_INLINE void fs_walker::pump() {
+    while(!paused && !stopping && inflight < limit && !pending.empty()) {
+        auto curr = std::make_shared<job>(job{std::move(pending.front().first), pending.front().second});
+        pending.pop_front();
+
+        auto dir = owner->resource<fs_req>();
+        auto entry = owner->resource<fs_req>();
+
+        auto work = owner->resource<work_req>([curr, dir, entry, follow = links, info = info, count = count]() {
+            read(*dir, *entry, *curr, follow, info, count);
+        });
+
+        work->on<work_event>([this, curr](const work_event &, work_req &) {
+            complete(*curr);
+        });
+
+        work->on<error_event>([this, curr](const error_event &event, work_req &) {
+            curr->error = event.code();
+            complete(*curr);
+        });
+
+        if(auto err = work->queue(); err != 0) {
+            publish(error_event{err});
+        } else {
+            ++inflight;
+        }
+    }
+}
+
+UVW_INLINE void fs_walker::flush() {
+    while(!paused && !stopping && !ready.empty()) {
+        fs_walk_event event{std::move(ready.front())};
+        ready.pop_front();
+        publish(std::move(event));
+    }
+}
+
+UVW_INLINE void fs_walker::complete(job &curr) {
+    --inflight;
+
+    if(!stopping) {
+        if(curr.error != 0) {
+            publish(error_event{curr.error});
+        }
+
+        // directories reached more than once through symbolic links are walked only the first time
+        if(!curr.known || visited.emplace(curr.stat.st_dev, curr.stat.st_ino).second) {
+            for(auto &&entries: curr.batches) {
+                if(predicate) {
+                    entries.erase(std::remove_if(entries.begin(), entries.end(), [this](const auto &elem) { return !predicate(elem); }), entries.end());
+                }
+
+                for(auto &&elem: entries) {
+                    if(elem.type == fs_req::entry_type::DIR) {
+                        pending.emplace_back(elem.path, elem.depth + 1u);
+                    }
+                }
+
+                if(!entries.empty()) {
+                    ready.push_back(std::move(entries));
+                }
+            }
+        }
+    }
+
+    advance();
+}
+
+UVW_INLINE void fs_walker::advance() {
+    flush();
+    pump();
+
+    if(self && !inflight && pending.empty() && ready.empty()) {
+        [[maybe_unused]] auto ptr = std::move(self);
+        publish(fs_walk_end_event{});
+    }
+}
+
+UVW_INLINE fs_walker::fs_walker(loop::token, std::shared_ptr<loop> ref)
+    : owner{std::move(ref)},
+      self{},
+      predicate{},
+      pending{},
+      ready{},
+      visited{},
+      limit{4u},
+      count{256u},
+      inflight{},
+      info{},
+      links{},
+      paused{},
+      stopping{} {}
+
+UVW_INLINE loop &fs_walker::parent() const noexcept {
+    return *owner;
+}
+
+UVW_INLINE void fs_walker::concurrency(std::size_t value) noexcept {
+    limit = value ? value : 1u;
+}
+
+UVW_INLINE void fs_walker::batch(std::size_t value) noexcept {
+    count = value ? value : 1u;
+}
+
+UVW_INLINE void fs_walker::stat(bool value) noexcept {
+    info = value;
+}
+
+UVW_INLINE void fs_walker::follow(bool value) noexcept {
+    links = value;
+}
+
+UVW_INLINE void fs_walker::filter(filter_type func) {
+    predicate = std::move(func);
+}
+
+UVW_INLINE int fs_walker::start(const std::string &path) {
+    if(self) {
+        return UV_EBUSY;
+    }
+
+    visited.clear();
+    paused = stopping = false;
+    pending.emplace_back(path, 0u);
+    self = shared_from_this();
+    advance();
+
+    return 0;
+}
+
+UVW_INLINE void fs_walker::pause() noexcept {
+    paused = true;
+}
+
+UVW_INLINE void fs_walker::resume() {
+    if(std::exchange(paused, false)) {
+        advance();
+    }
+}
+
+UVW_INLINE void fs_walker::stop() {
+    if(self && !stopping) {
+        stopping = true;
+        pending.clear();
+        ready.clear();
+        advance();
+    }
+}
+
+UVW_INLINE bool fs_walker::active() const noexcept {
+    return static_cast<bool>(self);
+}
+
+} // namespace uvw
@@ -37,6 +37,9 @@ protected:
         return reinterpret_cast<const uv_handle_t *>(this->raw());
     }
 
+    // derived types shadow it to release what goes along with the handle
+    void before_close() {}
+
 public:
     using resource<T, U, close_event, E...>::resource;
 
@@ -109,8 +112,9 @@ public:
      *
      * The handle will emit a close event when finished.
      */
-    void close() noexcept {
+    void close() {
         if(!closing()) {
+            static_cast<T &>(*this).before_close();
             uv_close(as_uv_handle(), &handle<T, U, E...>::close_callback);
         }
     }
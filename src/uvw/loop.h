@@ -13,6 +13,7 @@
 #include <uv.h>
 #include "config.h"
 #include "emitter.h"
+#include "pool.h"
 #include "util.h"
 
 namespace uvw {
@@ -59,6 +60,7 @@ using metrics_type = uv_metrics_t; /*!< Library equivalent for uv_metrics_t. */
  */
 class loop final: public emitter<loop>, public std::enable_shared_from_this<loop> {
     using deleter = void (*)(uv_loop_t *);
+    using pool_deleter = void (*)(buffer_pool *);
 
     template<typename, typename, typename...>
     friend class resource;
@@ -78,7 +80,7 @@ class loop final: public emitter<loop>, public std::enable_shared_from_this<loop
         return 0;
     }
 
-    loop(std::unique_ptr<uv_loop_t, deleter> ptr) noexcept;
+    loop(std::unique_ptr<uv_loop_t, deleter> ptr);
 
 public:
     using token = uv_token;
@@ -175,6 +177,26 @@ public:
         return std::make_shared<R>(token{0}, shared_from_this(), std::forward<Args>(args)...);
     }
 
+    /**
+     * @brief Creates resources of any type, recycling their memory.
+     *
+     * It works like `resource()` but the memory of the resource comes from the
+     * buffer pool of the loop and goes back to it once the resource is
+     * destroyed. This is meant for short-lived resources, such as the requests
+     * created internally for writes, sends, connections and shutdowns.
+     *
+     * @note
+     * Resources created this way must be destroyed on the thread that runs the
+     * loop, see `buffer_pool` for further details.
+     *
+     * @return A pointer to the newly created resource.
+     */
+    template<typename R, typename... Args>
+    std::shared_ptr<R> recycled_resource(Args &&...args) {
+        auto ptr = std::allocate_shared<R>(details::pool_allocator<R>{*pool}, token{0}, shared_from_this(), std::forward<Args>(args)...);
+        return (init(0, *ptr) == 0) ? ptr : nullptr;
+    }
+
     /**
      * @brief Releases all internal loop resources.
      *
@@ -278,6 +300,17 @@ public:
      */
     void update() const noexcept;
 
+    /**
+     * @brief Gets the buffer pool of the loop.
+     *
+     * Streams and UDP handles get their read buffers from this pool unless a
+     * custom allocation function is provided. Buffers are given back to the
+     * pool once the events that carry them are destroyed.
+     *
+     * @return A reference to the buffer pool of the loop.
+     */
+    buffer_pool &buffers() noexcept;
+
     /**
      * @brief Walks the list of handles.
      *
@@ -427,6 +460,7 @@ public:
 
 private:
     std::unique_ptr<uv_loop_t, deleter> uv_loop;
+    std::unique_ptr<buffer_pool, pool_deleter> pool;
     std::shared_ptr<void> user_data{nullptr};
 };
 
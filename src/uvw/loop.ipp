@@ -2,8 +2,9 @@
 
 namespace uvw {
 
-UVW_INLINE loop::loop(std::unique_ptr<uv_loop_t, deleter> ptr) noexcept
-    : uv_loop{std::move(ptr)} {}
+UVW_INLINE loop::loop(std::unique_ptr<uv_loop_t, deleter> ptr)
+    : uv_loop{std::move(ptr)},
+      pool{new buffer_pool{}, &buffer_pool::destroy} {}
 
 UVW_INLINE std::shared_ptr<loop> loop::create() {
     auto ptr = std::unique_ptr<uv_loop_t, deleter>{new uv_loop_t, [](uv_loop_t *l) { delete l; }};
@@ -97,6 +98,10 @@ UVW_INLINE void loop::update() const noexcept {
     return uv_update_time(uv_loop.get());
 }
 
+UVW_INLINE buffer_pool &loop::buffers() noexcept {
+    return *pool;
+}
+
 UVW_INLINE int loop::fork() noexcept {
     return uv_loop_fork(uv_loop.get());
 }
@@ -0,0 +1,2 @@
+#include "loop_group.h"
+#include "loop_group.ipp"
@@ -0,0 +1,190 @@
+#ifndef UVW_LOOP_GROUP_INCLUDE_H
+#define UVW_LOOP_GROUP_INCLUDE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <uv.h>
+#include "async.h"
+#include "check.h"
+#include "config.h"
+#include "fs_event.h"
+#include "fs_poll.h"
+#include "idle.h"
+#include "loop.h"
+#include "pipe.h"
+#include "poll.h"
+#include "prepare.h"
+#include "process.h"
+#include "signal.h"
+#include "tcp.h"
+#include "thread.h"
+#include "timer.h"
+#include "tty.h"
+#include "udp.h"
+
+namespace uvw {
+
+namespace details {
+
+enum class uvw_loop_group_mode : std::uint8_t {
+    REUSEPORT,
+    IPC
+};
+
+} // namespace details
+
+/**
+ * @brief Group of loops, each one running on its own thread.
+ *
+ * A loop group spreads a single logical server across multiple loops (usually
+ * one per core). Two modes are available to distribute connections:
+ *
+ * * `loop_group::mode::REUSEPORT`: every loop binds its own listening socket
+ * with `SO_REUSEPORT` and the kernel balances incoming connections.
+ * * `loop_group::mode::IPC`: the first loop accepts all the connections and
+ * hands them to the other loops in a round-robin fashion over IPC pipes. The
+ * first loop serves its share of connections too.
+ *
+ * Loops are stopped by closing all their handles, so that pending requests are
+ * cancelled and all close events are emitted before the threads return.
+ *
+ * @note
+ * Callbacks run on the threads of the loops. Loops must not be used directly
+ * from other threads while the group is running.
+ */
+class loop_group final {
+    struct worker {
+        std::size_t index;
+        std::shared_ptr<loop> ref;
+        std::shared_ptr<thread> runner{};
+        std::shared_ptr<async_handle> stopper{};
+        std::shared_ptr<pipe_handle> inbound{};
+        std::shared_ptr<pipe_handle> outbound{};
+        std::deque<std::shared_ptr<tcp_handle>> handoff{};
+    };
+
+    static void pin(std::size_t pos) noexcept;
+
+    void accept(tcp_handle &conn, std::size_t pos);
+    void hand_off(std::shared_ptr<tcp_handle> conn);
+    int listen(const std::string &ip, unsigned int port, bool reuse, int backlog);
+    int channel(worker &elem);
+    void release() noexcept;
+
+public:
+    using mode = details::uvw_loop_group_mode;
+    using task = std::function<void(loop &, std::size_t)>;
+    using accept_task = std::function<void(tcp_handle &, std::size_t)>;
+
+    /**
+     * @brief Constructs a group of loops.
+     * @param count The number of loops, the available parallelism if 0.
+     */
+    explicit loop_group(std::size_t count = {});
+
+    loop_group(const loop_group &) = delete;
+    loop_group(loop_group &&) = delete;
+
+    loop_group &operator=(const loop_group &) = delete;
+    loop_group &operator=(loop_group &&) = delete;
+
+    /*! @brief Stops the loops and waits for the threads to return. */
+    ~loop_group() noexcept;
+
+    /**
+     * @brief Returns the number of loops in the group.
+     * @return The number of loops in the group.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief Returns the loop at the given position.
+     * @param pos The position of the loop within the group.
+     * @return A reference to the requested loop.
+     */
+    [[nodiscard]] loop &operator[](std::size_t pos) const noexcept;
+
+    /**
+     * @brief Pins the threads of the group to a CPU each.
+     *
+     * Threads are pinned when they start, the i-th thread to the i-th CPU
+     * (modulo the number of CPUs). Pinning is on a best-effort basis and it's
+     * silently ignored on platforms that don't support it.
+     *
+     * This function must be invoked before the group is started.
+     *
+     * @param value True to pin threads to CPUs, false otherwise.
+     */
+    void affinity(bool value) noexcept;
+
+    /**
+     * @brief Starts a thread for each loop.
+     *
+     * The given function is invoked on each thread with the loop and its
+     * position within the group, before the loop runs.
+     *
+     * @param func A function to invoke on each thread, if any.
+     * @return Underlying return value.
+     */
+    int run(task func = {});
+
+    /**
+     * @brief Accepts connections on all the loops of the group.
+     *
+     * Listening sockets are set up before starting the threads, binding errors
+     * are therefore reported immediately and no thread is started in this
+     * case.<br/>
+     * The given function is invoked on the thread of the loop that owns the
+     * connection, with the accepted handle and the position of the loop. It's
+     * shared by all the threads of the group and is invoked concurrently.
+     *
+     * @note
+     * The IPC mode relies on `uv_socketpair` and IPC pipes. As such, it's
+     * supported only on Unix platforms.
+     *
+     * @param ip The address to which to bind.
+     * @param port The port to which to bind.
+     * @param func A function to invoke for each accepted connection.
+     * @param how The mode used to distribute connections.
+     * @param backlog Indicates the number of connections the kernel might
+     * queue, same as listen(2).
+     * @return Underlying return value.
+     */
+    int serve(const std::string &ip, unsigned int port, accept_task func, mode how = mode::REUSEPORT, int backlog = 128);
+
+    /**
+     * @brief Asks all the loops to stop.
+     *
+     * All the handles of the loops are closed, the loops return as soon as
+     * their close events are emitted.<br/>
+     * It's safe to call this function from any thread, including the ones of
+     * the group.
+     */
+    void stop() noexcept;
+
+    /*! @brief Waits for the threads of the group to return. */
+    void join() noexcept;
+
+private:
+    std::vector<worker> workers;
+    accept_task callback;
+    std::atomic_bool stopping;
+    std::size_t next;
+    char token;
+    bool pinned;
+    bool running;
+};
+
+} // namespace uvw
+
+#ifndef UVW_AS_LIB
+#    include "loop_group.ipp"
+#endif
+
+#endif // UVW_LOOP_GROUP_INCLUDE_H
@@ -0,0 +1,269 @@
+#include <algorithm>
+#include <utility>
+#include "config.h"
+
+#ifndef _WIN32
+#    include <unistd.h>
+#endif
+
+namespace uvw {
+
+UVW_INLINE void loop_group::pin(std::size_t pos) noexcept {
+    const auto size = uv_cpumask_size();
+    const auto cpus = std::min<std::size_t>(static_cast<std::size_t>(size), uv_available_parallelism());
+
+    if(size > 0 && cpus != 0u) {
+        std::vector<char> mask(static_cast<std::size_t>(size), 0);
+        mask[pos % cpus] = 1;
+        auto self = uv_thread_self();
+        // best effort, there is nothing to do in case of errors
+        uv_thread_setaffinity(&self, mask.data(), nullptr, mask.size());
+    }
+}
+
+UVW_INLINE void loop_group::accept(tcp_handle &conn, std::size_t pos) {
+    if(callback) {
+        callback(conn, pos);
+    }
+}
+
+UVW_INLINE void loop_group::hand_off(std::shared_ptr<tcp_handle> conn) {
+    const auto pos = std::exchange(next, (next + 1u) % workers.size());
+
+    if(pos == 0u) {
+        accept(*conn, pos);
+    } else {
+        auto &elem = workers[pos];
+
+        // the handle must outlive the write request, it's closed once the socket has been sent
+        if(elem.outbound->write(*conn, &token, 1u) == 0) {
+            elem.handoff.push_back(std::move(conn));
+        } else {
+            conn->close();
+        }
+    }
+}
+
+UVW_INLINE int loop_group::listen(const std::string &ip, unsigned int port, bool reuse, int backlog) {
+    const auto opts = reuse ? tcp_handle::tcp_flags::REUSEPORT : tcp_handle::tcp_flags::UVW_ENUM;
+    const auto count = reuse ? workers.size() : 1u;
+
+    for(std::size_t pos{}; pos < count; ++pos) {
+        auto server = workers[pos].ref->resource<tcp_handle>();
+
+        server->on<listen_event>([this, reuse, pos](const listen_event &, tcp_handle &srv) {
+            auto conn = srv.parent().resource<tcp_handle>();
+
+            if(srv.accept(*conn) != 0) {
+                conn->close();
+            } else if(reuse) {
+                accept(*conn, pos);
+            } else {
+                hand_off(std::move(conn));
+            }
+        });
+
+        if(auto err = server->bind(ip, port, opts); err != 0) {
+            return err;
+        }
+
+        if(auto err = server->listen(backlog); err != 0) {
+            return err;
+        }
+    }
+
+    return 0;
+}
+
+UVW_INLINE int loop_group::channel(worker &elem) {
+    uv_os_sock_t fds[2];
+
+    if(auto err = uv_socketpair(SOCK_STREAM, 0, fds, 0, 0); err != 0) {
+        return err;
+    }
+
+    elem.outbound = workers.front().ref->resource<pipe_handle>(true);
+    elem.inbound = elem.ref->resource<pipe_handle>(true);
+
+    elem.outbound->on<write_event>([&elem](const write_event &, pipe_handle &) {
+        elem.handoff.front()->close();
+        elem.handoff.pop_front();
+    });
+
+    elem.outbound->on<error_event>([&elem](const error_event &, pipe_handle &) {
+        if(!elem.handoff.empty()) {
+            elem.handoff.front()->close();
+            elem.handoff.pop_front();
+        }
+    });
+
+    elem.inbound->on<data_event>([this, pos = elem.index](const data_event &, pipe_handle &hndl) {
+        while(hndl.pending() > 0) {
+            auto conn = hndl.parent().resource<tcp_handle>();
+
+            if(hndl.accept(*conn) == 0) {
+                accept(*conn, pos);
+            } else {
+                conn->close();
+            }
+        }
+    });
+
+    // descriptors belong to the pipes only once opened, the others are closed on errors
+    const auto dispose = [](uv_os_sock_t sock) {
+#ifdef _WIN32
+        closesocket(sock);
+#else
+        ::close(sock);
+#endif
+    };
+
+    if(auto err = elem.outbound->open(file_handle{static_cast<uv_file>(fds[0])}); err != 0) {
+        dispose(fds[0]);
+        dispose(fds[1]);
+        return err;
+    }
+
+    if(auto err = elem.inbound->open(file_handle{static_cast<uv_file>(fds[1])}); err != 0) {
+        dispose(fds[1]);
+        return err;
+    }
+
+    return elem.inbound->read();
+}
+
+UVW_INLINE void loop_group::release() noexcept {
+    // loops that never ran (or returned early) may still own handles, close them all
+    for(auto &&elem: workers) {
+        elem.ref->walk([](auto &curr) { curr.close(); });
+        elem.ref->run(loop::run_mode::NOWAIT);
+
+        elem.runner.reset();
+        elem.stopper.reset();
+        elem.inbound.reset();
+        elem.outbound.reset();
+        elem.handoff.clear();
+    }
+
+    stopping = true;
+    running = false;
+}
+
+UVW_INLINE loop_group::loop_group(std::size_t count)
+    : workers{},
+      callback{},
+      stopping{true},
+      next{},
+      token{},
+      pinned{},
+      running{} {
+    count = count ? count : utilities::available_parallelism();
+    workers.reserve(count);
+
+    for(std::size_t pos{}; pos < count; ++pos) {
+        workers.push_back(worker{pos, loop::create()});
+    }
+}
+
+UVW_INLINE loop_group::~loop_group() noexcept {
+    stop();
+    join();
+}
+
+UVW_INLINE std::size_t loop_group::size() const noexcept {
+    return workers.size();
+}
+
+UVW_INLINE loop &loop_group::operator[](std::size_t pos) const noexcept {
+    return *workers[pos].ref;
+}
+
+UVW_INLINE void loop_group::affinity(bool value) noexcept {
+    pinned = value;
+}
+
+UVW_INLINE int loop_group::run(task func) {
+    if(running) {
+        return UV_EBUSY;
+    }
+
+    running = true;
+
+    // stop signals are set up for all the loops first, any thread can stop the group once started
+    for(auto &&elem: workers) {
+        elem.stopper = elem.ref->resource<async_handle>();
+
+        elem.stopper->on<async_event>([](const async_event &, async_handle &hndl) {
+            hndl.parent().walk([](auto &curr) { curr.close(); });
+        });
+    }
+
+    stopping = false;
+
+    for(auto &&elem: workers) {
+        elem.runner = elem.ref->resource<thread>([this, &elem, func](std::shared_ptr<void>) {
+            if(pinned) {
+                pin(elem.index);
+            }
+
+            if(func) {
+                func(*elem.ref, elem.index);
+            }
+
+            elem.ref->run();
+        });
+
+        if(!elem.runner->run()) {
+            stop();
+            join();
+            return UV_EAGAIN;
+        }
+    }
+
+    return 0;
+}
+
+UVW_INLINE int loop_group::serve(const std::string &ip, unsigned int port, accept_task func, mode how, int backlog) {
+    if(running) {
+        return UV_EBUSY;
+    }
+
+    callback = std::move(func);
+    next = 0u;
+
+    const bool reuse = (how == mode::REUSEPORT);
+    auto err = listen(ip, port, reuse, backlog);
+
+    for(std::size_t pos = 1u; !reuse && !err && pos < workers.size(); ++pos) {
+        err = channel(workers[pos]);
+    }
+
+    if(err != 0) {
+        release();
+        return err;
+    }
+
+    return run();
+}
+
+UVW_INLINE void loop_group::stop() noexcept {
+    if(!stopping.exchange(true)) {
+        for(auto &&elem: workers) {
+            elem.stopper->send();
+        }
+    }
+}
+
+UVW_INLINE void loop_group::join() noexcept {
+    if(running) {
+        for(auto &&elem: workers) {
+            if(elem.runner) {
+                elem.runner->join();
+            }
+        }
+
+        release();
+    }
+}
+
+} // namespace uvw
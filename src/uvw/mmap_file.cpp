@@ -0,0 +1,2 @@
+#include "mmap_file.h"
+#include "mmap_file.ipp"
@@ -0,0 +1,208 @@
+#ifndef UVW_MMAP_FILE_INCLUDE_H
+#define UVW_MMAP_FILE_INCLUDE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <uv.h>
+#include "config.h"
+#include "emitter.h"
+#include "loop.h"
+#include "util.h"
+#include "work.h"
+
+namespace uvw {
+
+namespace details {
+
+enum class uvw_mmap_access : int {
+    READ,
+    READ_WRITE
+};
+
+enum class uvw_mmap_advice : int {
+    NORMAL,
+    SEQUENTIAL,
+    RANDOM,
+    WILLNEED,
+    DONTNEED
+};
+
+enum class uvw_mmap_type : int {
+    SYNC,
+    PREFAULT
+};
+
+} // namespace details
+
+/**
+ * @brief Mmap event.
+ *
+ * It will be emitted by mmap_file according with its functionalities.
+ */
+struct mmap_event {
+    using mmap_type = details::uvw_mmap_type;
+
+    mmap_type type;     /*!< Actual event type. */
+    std::size_t offset; /*!< The offset of the range affected by the request. */
+    std::size_t length; /*!< The length of the range affected by the request. */
+};
+
+/**
+ * @brief The mmap file wrapper.
+ *
+ * It maps (part of) a file in memory, so that its content can be accessed
+ * without copying it into user buffers.<br/>
+ * Blocking operations such as syncing the mapping with the file or faulting
+ * its pages in are run on the threadpool and an event is emitted on the loop
+ * thread once they complete.
+ *
+ * The mapping doesn't take the ownership of the file, that can be closed as
+ * soon as it's mapped. The file must not be truncated while it's mapped,
+ * though. Accessing a page past the end of the file results in a `SIGBUS`
+ * otherwise.
+ *
+ * To create a `mmap_file` through a `loop`, no arguments are required.
+ */
+class mmap_file final: public emitter<mmap_file, mmap_event>, public std::enable_shared_from_this<mmap_file> {
+    [[nodiscard]] static std::size_t granularity() noexcept;
+    [[nodiscard]] static std::size_t page_size() noexcept;
+    [[nodiscard]] static int execute(details::uvw_mmap_type type, char *addr, std::size_t len) noexcept;
+
+    [[nodiscard]] std::pair<char *, std::size_t> range(std::size_t offset, std::size_t length) const noexcept;
+    int submit(details::uvw_mmap_type type, std::size_t offset, std::size_t length);
+
+public:
+    using access = details::uvw_mmap_access;
+    using advice = details::uvw_mmap_advice;
+
+    explicit mmap_file(loop::token token, std::shared_ptr<loop> ref);
+
+    mmap_file(const mmap_file &) = delete;
+    mmap_file(mmap_file &&) = delete;
+
+    mmap_file &operator=(const mmap_file &) = delete;
+    mmap_file &operator=(mmap_file &&) = delete;
+
+    ~mmap_file() noexcept;
+
+    /**
+     * @brief Gets the loop from which the mapping was originated.
+     * @return A reference to a loop instance.
+     */
+    [[nodiscard]] loop &parent() const noexcept;
+
+    /**
+     * @brief Maps a file in memory.
+     *
+     * Available access modes are:
+     *
+     * * `mmap_file::access::READ`
+     * * `mmap_file::access::READ_WRITE`
+     *
+     * Changes to a mapping open for writing are carried through to the file.
+     * The file must be open with a compatible mode.
+     *
+     * @param file A valid file handle.
+     * @param mode The access mode of the mapping.
+     * @param offset The offset from which to map the file, any value is
+     * accepted.
+     * @param length The amount of data to map, 0 to map the file up to its end.
+     * @return Underlying return value.
+     */
+    int map(file_handle file, access mode = access::READ, int64_t offset = {}, std::size_t length = {});
+
+    /**
+     * @brief Unmaps the file.
+     *
+     * It fails with `UV_EBUSY` while there are requests in progress. A request
+     * is no longer in progress when its event is emitted. The file is unmapped
+     * automatically when the mapping is destroyed.
+     *
+     * @return Underlying return value.
+     */
+    int unmap() noexcept;
+
+    /**
+     * @brief Gets the content of the file.
+     * @return A pointer to the first byte mapped, if any.
+     */
+    [[nodiscard]] char *data() const noexcept;
+
+    /**
+     * @brief Gets the size of the mapping.
+     * @return The amount of data mapped, 0 if the file isn't mapped.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief Gives a hint about the expected access pattern.
+     *
+     * Available hints are:
+     *
+     * * `mmap_file::advice::NORMAL`
+     * * `mmap_file::advice::SEQUENTIAL`
+     * * `mmap_file::advice::RANDOM`
+     * * `mmap_file::advice::WILLNEED`
+     * * `mmap_file::advice::DONTNEED`
+     *
+     * See [posix_madvise](https://man7.org/linux/man-pages/man3/posix_madvise.3.html)
+     * for further details. Hints are ignored on Windows.
+     *
+     * @param hint The expected access pattern.
+     * @param offset The offset of the range, relative to the mapping.
+     * @param length The length of the range, 0 up to the end of the mapping.
+     * @return Underlying return value.
+     */
+    int advise(advice hint, std::size_t offset = {}, std::size_t length = {}) noexcept;
+
+    /**
+     * @brief Async [msync](https://man7.org/linux/man-pages/man2/msync.2.html).
+     *
+     * Changes to the given range are written to the file on the threadpool.
+     * On Windows, dirty pages are flushed but file metadata aren't.<br/>
+     * Emit a `mmap_event` event when completed.
+     *
+     * @param offset The offset of the range, relative to the mapping.
+     * @param length The length of the range, 0 up to the end of the mapping.
+     * @return Underlying return value.
+     */
+    int sync(std::size_t offset = {}, std::size_t length = {});
+
+    /**
+     * @brief Sync [msync](https://man7.org/linux/man-pages/man2/msync.2.html).
+     * @param offset The offset of the range, relative to the mapping.
+     * @param length The length of the range, 0 up to the end of the mapping.
+     * @return True in case of success, false otherwise.
+     */
+    bool sync_sync(std::size_t offset = {}, std::size_t length = {}) noexcept;
+
+    /**
+     * @brief Faults in the pages of a range.
+     *
+     * Pages are touched one by one on the threadpool, so that accessing them
+     * later on doesn't block the loop thread.<br/>
+     * Emit a `mmap_event` event when completed.
+     *
+     * @param offset The offset of the range, relative to the mapping.
+     * @param length The length of the range, 0 up to the end of the mapping.
+     * @return Underlying return value.
+     */
+    int prefault(std::size_t offset = {}, std::size_t length = {});
+
+private:
+    std::shared_ptr<loop> owner;
+    char *base;
+    std::size_t mapped;
+    std::size_t delta;
+    std::size_t pending;
+};
+
+} // namespace uvw
+
+#ifndef UVW_AS_LIB
+#    include "mmap_file.ipp"
+#endif
+
+#endif // UVW_MMAP_FILE_INCLUDE_H
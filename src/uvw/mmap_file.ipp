@@ -0,0 +1,258 @@
+#include <utility>
+#include "config.h"
+
+#ifndef _WIN32
+#    include <cerrno>
+#    include <sys/mman.h>
+#    include <unistd.h>
+#endif
+
+namespace uvw {
+
+UVW_INLINE std::size_t mmap_file::granularity() noexcept {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<std::size_t>(info.dwAllocationGranularity);
+#else
+    return page_size();
+#endif
+}
+
+UVW_INLINE std::size_t mmap_file::page_size() noexcept {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<std::size_t>(info.dwPageSize);
+#else
+    return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+UVW_INLINE int mmap_file::execute(details::uvw_mmap_type type, char *addr, std::size_t len) noexcept {
+    switch(type) {
+    case details::uvw_mmap_type::SYNC:
+#ifdef _WIN32
+        return FlushViewOfFile(addr, len) ? 0 : uv_translate_sys_error(static_cast<int>(GetLastError()));
+#else
+        return (msync(addr, len, MS_SYNC) == 0) ? 0 : uv_translate_sys_error(errno);
+#endif
+    case details::uvw_mmap_type::PREFAULT:
+#ifndef _WIN32
+        // best effort, it starts the readahead of the whole range at once
+        posix_madvise(addr, len, POSIX_MADV_WILLNEED);
+#endif
+
+        for(std::size_t pos{}, step = page_size(); pos < len; pos += step) {
+            static_cast<void>(*static_cast<volatile char *>(addr + pos));
+        }
+
+        return 0;
+    }
+
+    return UV_EINVAL;
+}
+
+UVW_INLINE std::pair<char *, std::size_t> mmap_file::range(std::size_t offset, std::size_t length) const noexcept {
+    const auto count = size();
+
+    if(!base || offset >= count || length > (count - offset)) {
+        return {nullptr, 0u};
+    }
+
+    // ranges must start at a page boundary, the mapping itself does
+    const auto first = (delta + offset) & ~(page_size() - 1u);
+    const auto last = delta + offset + (length ? length : (count - offset));
+
+    return {base + first, last - first};
+}
+
+UVW_INLINE int mmap_file::submit(details::uvw_mmap_type type, std::size_t offset, std::size_t length) {
+    auto [addr, len] = range(offset, length);
+
+    if(!addr) {
+        return UV_EINVAL;
+    }
+
+    const auto count = length ? length : (size() - offset);
+    auto status = std::make_shared<int>();
+    auto work = owner->resource<work_req>([type, addr = addr, len = len, status]() {
+        *status = execute(type, addr, len);
+    });
+
+    // the mapping is kept alive (and mapped) until the request completes
+    work->on<work_event>([ptr = shared_from_this(), type, offset, count, status](const work_event &, work_req &) {
+        --ptr->pending;
+
+        if(*status) {
+            ptr->publish(error_event{*status});
+        } else {
+            ptr->publish(mmap_event{type, offset, count});
+        }
+    });
+
+    work->on<error_event>([ptr = shared_from_this()](const error_event &event, work_req &) {
+        --ptr->pending;
+        ptr->publish(event);
+    });
+
+    if(auto err = work->queue(); err != 0) {
+        return err;
+    }
+
+    ++pending;
+    return 0;
+}
+
+UVW_INLINE mmap_file::mmap_file(loop::token, std::shared_ptr<loop> ref)
+    : owner{std::move(ref)},
+      base{},
+      mapped{},
+      delta{},
+      pending{} {}
+
+UVW_INLINE mmap_file::~mmap_file() noexcept {
+    unmap();
+}
+
+UVW_INLINE loop &mmap_file::parent() const noexcept {
+    return *owner;
+}
+
+UVW_INLINE int mmap_file::map(file_handle file, access mode, int64_t offset, std::size_t length) {
+    if(base) {
+        return UV_EBUSY;
+    }
+
+    if(offset < 0) {
+        return UV_EINVAL;
+    }
+
+    if(!length) {
+        uv_fs_t req{};
+        const auto err = uv_fs_fstat(owner->raw(), &req, file, nullptr);
+        const auto total = req.statbuf.st_size;
+        uv_fs_req_cleanup(&req);
+
+        if(err != 0) {
+            return err;
+        } else if(total <= static_cast<uint64_t>(offset)) {
+            return UV_EINVAL;
+        }
+
+        length = static_cast<std::size_t>(total - static_cast<uint64_t>(offset));
+    }
+
+    // mappings must start at a multiple of the allocation granularity
+    const auto start = static_cast<uint64_t>(offset) & ~static_cast<uint64_t>(granularity() - 1u);
+    const auto shift = static_cast<std::size_t>(static_cast<uint64_t>(offset) - start);
+    const bool writable = (mode == access::READ_WRITE);
+
+#ifdef _WIN32
+    const auto end = start + shift + length;
+    HANDLE mapping = CreateFileMappingW(uv_get_osfhandle(file), nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, static_cast<DWORD>(end >> 32u), static_cast<DWORD>(end & 0xFFFFFFFFu), nullptr);
+
+    if(!mapping) {
+        return uv_translate_sys_error(static_cast<int>(GetLastError()));
+    }
+
+    void *view = MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, static_cast<DWORD>(start >> 32u), static_cast<DWORD>(start & 0xFFFFFFFFu), shift + length);
+    const auto error = GetLastError();
+    // the view keeps the mapping object alive
+    CloseHandle(mapping);
+
+    if(!view) {
+        return uv_translate_sys_error(static_cast<int>(error));
+    }
+#else
+    void *view = mmap(nullptr, shift + length, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, file, static_cast<off_t>(start));
+
+    if(view == MAP_FAILED) {
+        return uv_translate_sys_error(errno);
+    }
+#endif
+
+    base = static_cast<char *>(view);
+    mapped = shift + length;
+    delta = shift;
+
+    return 0;
+}
+
+UVW_INLINE int mmap_file::unmap() noexcept {
+    if(pending) {
+        return UV_EBUSY;
+    }
+
+    if(base) {
+#ifdef _WIN32
+        UnmapViewOfFile(base);
+#else
+        munmap(base, mapped);
+#endif
+        base = nullptr;
+        mapped = delta = 0u;
+    }
+
+    return 0;
+}
+
+UVW_INLINE char *mmap_file::data() const noexcept {
+    return base ? (base + delta) : nullptr;
+}
+
+UVW_INLINE std::size_t mmap_file::size() const noexcept {
+    return mapped - delta;
+}
+
+UVW_INLINE int mmap_file::advise(advice hint, std::size_t offset, std::size_t length) noexcept {
+    auto [addr, len] = range(offset, length);
+
+    if(!addr) {
+        return UV_EINVAL;
+    }
+
+#ifdef _WIN32
+    static_cast<void>(hint);
+    static_cast<void>(len);
+    return 0;
+#else
+    int value{};
+
+    switch(hint) {
+    case advice::NORMAL:
+        value = POSIX_MADV_NORMAL;
+        break;
+    case advice::SEQUENTIAL:
+        value = POSIX_MADV_SEQUENTIAL;
+        break;
+    case advice::RANDOM:
+        value = POSIX_MADV_RANDOM;
+        break;
+    case advice::WILLNEED:
+        value = POSIX_MADV_WILLNEED;
+        break;
+    case advice::DONTNEED:
+        value = POSIX_MADV_DONTNEED;
+        break;
+    }
+
+    // posix_madvise returns the error number rather than setting errno
+    return uv_translate_sys_error(posix_madvise(addr, len, value));
+#endif
+}
+
+UVW_INLINE int mmap_file::sync(std::size_t offset, std::size_t length) {
+    return submit(details::uvw_mmap_type::SYNC, offset, length);
+}
+
+UVW_INLINE bool mmap_file::sync_sync(std::size_t offset, std::size_t length) noexcept {
+    auto [addr, len] = range(offset, length);
+    return addr && (execute(details::uvw_mmap_type::SYNC, addr, len) == 0);
+}
+
+UVW_INLINE int mmap_file::prefault(std::size_t offset, std::size_t length) {
+    return submit(details::uvw_mmap_type::PREFAULT, offset, length);
+}
+
+} // namespace uvw
@@ -19,11 +19,11 @@ UVW_INLINE int pipe_handle::bind(const std::string &name, const bool no_truncate
 }
 
 UVW_INLINE int pipe_handle::connect(const std::string &name, const bool no_truncate) {
-    auto listener = [ptr = shared_from_this()](const auto &event, const auto &) {
+    auto listener = [ptr = this](const auto &event, const auto &) {
         ptr->publish(event);
     };
 
-    auto connect = parent().resource<details::connect_req>();
+    auto connect = parent().recycled_resource<details::connect_req>();
     connect->on<error_event>(listener);
     connect->on<connect_event>(listener);
 
@@ -0,0 +1,2 @@
+#include "pool.h"
+#include "pool.ipp"
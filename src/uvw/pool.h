@@ -0,0 +1,210 @@
+#ifndef UVW_POOL_INCLUDE_H
+#define UVW_POOL_INCLUDE_H
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <uv.h>
+#include "config.h"
+
+namespace uvw {
+
+/**
+ * @brief Deleter for buffers that may come from a buffer pool.
+ *
+ * Buffers obtained from a `buffer_pool` are given back to their pool, all the
+ * other buffers are released with `delete[]`.<br/>
+ * A default deleter for arrays of chars converts implicitly to this type, so
+ * that a plain `std::unique_ptr<char[]>` can be used where a pooled buffer is
+ * expected.
+ *
+ * @note
+ * Unlike `delete[]`, giving a buffer back to its pool isn't thread safe. Check
+ * `pooled()` before handing a buffer over to another thread.
+ */
+struct buffer_deleter {
+    explicit buffer_deleter(bool chunk = false) noexcept;
+    buffer_deleter(std::default_delete<char[]>) noexcept;
+
+    void operator()(char *ptr) const noexcept;
+
+    /**
+     * @brief Checks if the deleter refers to a pooled buffer.
+     * @return True if buffers are given back to a pool, false otherwise.
+     */
+    [[nodiscard]] bool pooled() const noexcept;
+
+private:
+    bool from_pool;
+};
+
+/**
+ * @brief Per-loop pool of memory chunks.
+ *
+ * Buffers are grouped in size classes (powers of two, up to the size that
+ * `libuv` suggests for reads) and released chunks are kept in a freelist per
+ * class, so that they can be reused without going through the heap.<br/>
+ * The amount of memory retained by the freelists never exceeds the _high-water
+ * mark_. Chunks released when the limit is reached are freed immediately.
+ * Requests larger than the biggest size class bypass the freelists.
+ *
+ * Every loop owns a pool, see `loop::buffers()`. Loops also use it to recycle
+ * the memory of short-lived resources, see `loop::recycled_resource()`.
+ *
+ * @note
+ * Pools aren't thread safe. Pooled buffers must be released on the thread that
+ * runs the loop, even though they can outlive the loop itself.
+ */
+class buffer_pool final {
+    friend class loop;
+
+    static constexpr std::size_t MIN_SHIFT = 10u;
+    static constexpr std::size_t MAX_SHIFT = 16u;
+    static constexpr std::size_t CLASSES = MAX_SHIFT - MIN_SHIFT + 1u;
+    static constexpr std::size_t UNPOOLED = CLASSES;
+    static constexpr std::size_t DEFAULT_HIGH_WATER_MARK = 1u << 20u;
+
+    struct alignas(alignof(std::max_align_t)) header {
+        buffer_pool *owner;
+        std::size_t size_class;
+    };
+
+    struct node {
+        node *next;
+    };
+
+    [[nodiscard]] static std::size_t class_of(std::size_t size) noexcept;
+    [[nodiscard]] static std::size_t size_of(std::size_t size_class) noexcept;
+    static void destroy(buffer_pool *pool) noexcept;
+
+    void trim(std::size_t bytes) noexcept;
+
+public:
+    buffer_pool() noexcept = default;
+
+    buffer_pool(const buffer_pool &) = delete;
+    buffer_pool(buffer_pool &&) = delete;
+
+    buffer_pool &operator=(const buffer_pool &) = delete;
+    buffer_pool &operator=(buffer_pool &&) = delete;
+
+    ~buffer_pool() noexcept;
+
+    /**
+     * @brief Gets a chunk of memory from the pool.
+     *
+     * The returned chunk can be larger than requested. It must be given back
+     * with `release()`.
+     *
+     * @param size The minimum size of the chunk.
+     * @return A `std::pair` composed as it follows:
+     * * A pointer to the chunk of memory.
+     * * The actual size of the chunk.
+     */
+    [[nodiscard]] std::pair<char *, std::size_t> allocate(std::size_t size);
+
+    /**
+     * @brief Gives a chunk of memory back to its pool.
+     * @param ptr A chunk of memory returned by `allocate()`, if any.
+     */
+    static void release(char *ptr) noexcept;
+
+    /**
+     * @brief Gets a buffer from the pool.
+     *
+     * The buffer goes back to the pool when the returned object is destroyed.
+     *
+     * @param size The minimum size of the buffer.
+     * @return A buffer of at least the given size.
+     */
+    [[nodiscard]] std::unique_ptr<char[], buffer_deleter> acquire(std::size_t size);
+
+    /**
+     * @brief Sets the maximum amount of memory retained by the freelists.
+     *
+     * Chunks exceeding the new limit are freed immediately.
+     *
+     * @param bytes The high-water mark in bytes.
+     */
+    void high_water_mark(std::size_t bytes) noexcept;
+
+    /**
+     * @brief Gets the maximum amount of memory retained by the freelists.
+     * @return The high-water mark in bytes.
+     */
+    [[nodiscard]] std::size_t high_water_mark() const noexcept;
+
+    /**
+     * @brief Gets the amount of memory currently retained by the freelists.
+     * @return The amount of memory retained by the freelists in bytes.
+     */
+    [[nodiscard]] std::size_t cached() const noexcept;
+
+    /**
+     * @brief Gets the number of chunks that haven't been released yet.
+     * @return The number of chunks currently in use.
+     */
+    [[nodiscard]] std::size_t outstanding() const noexcept;
+
+    /*! @brief Frees all the chunks retained by the freelists. */
+    void clear() noexcept;
+
+private:
+    std::array<node *, CLASSES> freelist{};
+    std::size_t limit{DEFAULT_HIGH_WATER_MARK};
+    std::size_t retained{};
+    std::size_t in_use{};
+    bool orphan{};
+};
+
+namespace details {
+
+template<typename Type>
+void pool_alloc_callback(uv_handle_t *handle, std::size_t suggested, uv_buf_t *buf) {
+    auto [alloc, size] = static_cast<const Type *>(handle->data)->parent().buffers().allocate(suggested);
+    *buf = uv_buf_init(alloc, static_cast<unsigned int>(size));
+}
+
+template<typename Type>
+struct pool_allocator {
+    using value_type = Type;
+
+    explicit pool_allocator(buffer_pool &ref) noexcept
+        : pool{&ref} {}
+
+    template<typename Other>
+    pool_allocator(const pool_allocator<Other> &other) noexcept
+        : pool{other.pool} {}
+
+    [[nodiscard]] Type *allocate(std::size_t n) {
+        static_assert(alignof(Type) <= alignof(std::max_align_t), "Over-aligned types aren't supported");
+        return reinterpret_cast<Type *>(pool->allocate(n * sizeof(Type)).first);
+    }
+
+    void deallocate(Type *ptr, std::size_t) noexcept {
+        buffer_pool::release(reinterpret_cast<char *>(ptr));
+    }
+
+    template<typename Other>
+    [[nodiscard]] bool operator==(const pool_allocator<Other> &other) const noexcept {
+        return pool == other.pool;
+    }
+
+    template<typename Other>
+    [[nodiscard]] bool operator!=(const pool_allocator<Other> &other) const noexcept {
+        return pool != other.pool;
+    }
+
+    buffer_pool *pool;
+};
+
+} // namespace details
+
+} // namespace uvw
+
+#ifndef UVW_AS_LIB
+#    include "pool.ipp"
+#endif
+
+#endif // UVW_POOL_INCLUDE_H
@@ -0,0 +1,137 @@
+#include <new>
+#include "config.h"
+
+namespace uvw {
+
+UVW_INLINE buffer_deleter::buffer_deleter(bool chunk) noexcept
+    : from_pool{chunk} {}
+
+UVW_INLINE buffer_deleter::buffer_deleter(std::default_delete<char[]>) noexcept
+    : from_pool{false} {}
+
+UVW_INLINE void buffer_deleter::operator()(char *ptr) const noexcept {
+    if(from_pool) {
+        buffer_pool::release(ptr);
+    } else {
+        delete[] ptr;
+    }
+}
+
+UVW_INLINE bool buffer_deleter::pooled() const noexcept {
+    return from_pool;
+}
+
+UVW_INLINE std::size_t buffer_pool::class_of(std::size_t size) noexcept {
+    std::size_t size_class = 0u;
+
+    while(size_class < CLASSES && size_of(size_class) < size) {
+        ++size_class;
+    }
+
+    return size_class;
+}
+
+UVW_INLINE std::size_t buffer_pool::size_of(std::size_t size_class) noexcept {
+    return std::size_t{1u} << (size_class + MIN_SHIFT);
+}
+
+UVW_INLINE void buffer_pool::destroy(buffer_pool *pool) noexcept {
+    pool->clear();
+
+    if(pool->in_use) {
+        // the last chunk given back to the pool will delete it
+        pool->orphan = true;
+    } else {
+        delete pool;
+    }
+}
+
+UVW_INLINE void buffer_pool::trim(std::size_t bytes) noexcept {
+    for(std::size_t size_class = CLASSES; size_class && retained > bytes; --size_class) {
+        auto &head = freelist[size_class - 1u];
+
+        while(head && retained > bytes) {
+            auto *hdr = reinterpret_cast<header *>(head) - 1;
+            head = head->next;
+            retained -= size_of(hdr->size_class);
+            ::operator delete(hdr);
+        }
+    }
+}
+
+UVW_INLINE buffer_pool::~buffer_pool() noexcept {
+    clear();
+}
+
+UVW_INLINE std::pair<char *, std::size_t> buffer_pool::allocate(std::size_t size) {
+    const auto size_class = class_of(size);
+    header *hdr = nullptr;
+
+    if(size_class == UNPOOLED) {
+        hdr = static_cast<header *>(::operator new(sizeof(header) + size));
+    } else {
+        size = size_of(size_class);
+
+        if(auto *&head = freelist[size_class]; head) {
+            hdr = reinterpret_cast<header *>(head) - 1;
+            head = head->next;
+            retained -= size;
+        } else {
+            hdr = static_cast<header *>(::operator new(sizeof(header) + size));
+        }
+    }
+
+    hdr->owner = this;
+    hdr->size_class = size_class;
+    ++in_use;
+
+    return {reinterpret_cast<char *>(hdr + 1), size};
+}
+
+UVW_INLINE void buffer_pool::release(char *ptr) noexcept {
+    if(ptr) {
+        auto *hdr = reinterpret_cast<header *>(ptr) - 1;
+        auto *pool = hdr->owner;
+        --pool->in_use;
+
+        if(hdr->size_class == UNPOOLED || pool->orphan || (pool->retained + size_of(hdr->size_class)) > pool->limit) {
+            ::operator delete(hdr);
+        } else {
+            auto *elem = reinterpret_cast<node *>(ptr);
+            elem->next = pool->freelist[hdr->size_class];
+            pool->freelist[hdr->size_class] = elem;
+            pool->retained += size_of(hdr->size_class);
+        }
+
+        if(pool->orphan && !pool->in_use) {
+            delete pool;
+        }
+    }
+}
+
+UVW_INLINE std::unique_ptr<char[], buffer_deleter> buffer_pool::acquire(std::size_t size) {
+    return std::unique_ptr<char[], buffer_deleter>{allocate(size).first, buffer_deleter{true}};
+}
+
+UVW_INLINE void buffer_pool::high_water_mark(std::size_t bytes) noexcept {
+    limit = bytes;
+    trim(limit);
+}
+
+UVW_INLINE std::size_t buffer_pool::high_water_mark() const noexcept {
+    return limit;
+}
+
+UVW_INLINE std::size_t buffer_pool::cached() const noexcept {
+    return retained;
+}
+
+UVW_INLINE std::size_t buffer_pool::outstanding() const noexcept {
+    return in_use;
+}
+
+UVW_INLINE void buffer_pool::clear() noexcept {
+    trim(0u);
+}
+
+} // namespace uvw
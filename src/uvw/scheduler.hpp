@@ -0,0 +1,834 @@
+#ifndef UVW_SCHEDULER_INCLUDE_H
+#define UVW_SCHEDULER_INCLUDE_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <uv.h>
+#include "async.h"
+#include "config.h"
+#include "emitter.h"
+#include "handle.hpp"
+#include "loop.h"
+#include "work.h"
+
+namespace uvw {
+
+namespace details {
+
+struct scheduled_node {
+    using function_type = void (*)(scheduled_node *);
+
+    explicit scheduled_node(function_type func) noexcept
+        : next{},
+          execute{func} {}
+
+    scheduled_node *next;
+    function_type execute;
+};
+
+template<typename Type>
+using value_or_monostate_t = std::conditional_t<std::is_void_v<Type>, std::monostate, Type>;
+
+template<typename Func, typename Type>
+struct invoke_value {
+    using type = std::invoke_result_t<Func &, Type>;
+};
+
+template<typename Func>
+struct invoke_value<Func, void> {
+    using type = std::invoke_result_t<Func &>;
+};
+
+template<typename Receiver, typename Type>
+void set_value(Receiver &receiver, std::optional<Type> &value) {
+    if constexpr(std::is_same_v<Type, std::monostate>) {
+        receiver.set_value();
+    } else {
+        receiver.set_value(std::move(*value));
+    }
+}
+
+} // namespace details
+
+class loop_scheduler;
+
+/**
+ * @brief The run queue.
+ *
+ * A run queue moves work to the loop it belongs to, from any thread. Work items
+ * are the operation states of the senders themselves, so that queueing them
+ * doesn't allocate. The loop is woken up through an async handle.
+ *
+ * The queue must be initialized on the thread that runs the loop. Work
+ * scheduled from that thread is run inline.
+ *
+ * Like handles, a run queue keeps itself alive until it's closed. It must not
+ * be closed while there is still work scheduled on it.
+ *
+ * To create a `run_queue` through a `loop`, no arguments are required.
+ *
+ * @note
+ * The underlying async handle is visible when walking the loop. Closing it
+ * closes the queue as well.
+ */
+class run_queue final: public emitter<run_queue, close_event>, public std::enable_shared_from_this<run_queue> {
+    void drain() {
+        details::scheduled_node *curr{};
+
+        {
+            std::lock_guard<std::mutex> guard{mutex};
+            curr = std::exchange(head, nullptr);
+            tail = nullptr;
+        }
+
+        while(curr) {
+            // nodes can be destroyed as soon as they are executed
+            auto *node = std::exchange(curr, curr->next);
+            node->execute(node);
+        }
+    }
+
+public:
+    explicit run_queue(loop::token, std::shared_ptr<loop> ref)
+        : owner{std::move(ref)},
+          waker{},
+          self{},
+          mutex{},
+          head{},
+          tail{},
+          id{} {}
+
+    run_queue(const run_queue &) = delete;
+    run_queue(run_queue &&) = delete;
+
+    run_queue &operator=(const run_queue &) = delete;
+    run_queue &operator=(run_queue &&) = delete;
+
+    /**
+     * @brief Initializes the queue.
+     * @return Underlying return value.
+     */
+    int init() {
+        waker = owner->uninitialized_resource<async_handle>();
+
+        waker->on<async_event>([this](const async_event &, async_handle &) {
+            drain();
+        });
+
+        waker->on<close_event>([this](const close_event &, async_handle &) {
+            [[maybe_unused]] auto ptr = std::move(self);
+            publish(close_event{});
+        });
+
+        const auto err = waker->init();
+
+        if(err == 0) {
+            id = std::this_thread::get_id();
+            self = shared_from_this();
+        }
+
+        return err;
+    }
+
+    /**
+     * @brief Gets the loop from which the queue was originated.
+     * @return A reference to a loop instance.
+     */
+    [[nodiscard]] loop &parent() const noexcept {
+        return *owner;
+    }
+
+    /**
+     * @brief Gets a scheduler for the queue.
+     * @return A scheduler that runs work on the loop of the queue.
+     */
+    [[nodiscard]] loop_scheduler scheduler() noexcept;
+
+    /**
+     * @brief Checks if the caller runs on the thread of the loop.
+     * @return True if the caller runs on the thread of the loop, false
+     * otherwise.
+     */
+    [[nodiscard]] bool running_in_this_thread() const noexcept {
+        return (std::this_thread::get_id() == id);
+    }
+
+    /**
+     * @brief Schedules a node for execution on the thread of the loop.
+     *
+     * Used internally by senders. It's safe to call this function from any
+     * thread.
+     *
+     * @param node A node that outlives its execution.
+     */
+    void post(details::scheduled_node &node) {
+        {
+            std::lock_guard<std::mutex> guard{mutex};
+            node.next = nullptr;
+            (tail ? tail->next : head) = &node;
+            tail = &node;
+        }
+
+        waker->send();
+    }
+
+    /**
+     * @brief Requests the queue to be closed.
+     *
+     * A close event is emitted when the queue has been closed.
+     */
+    void close() noexcept {
+        waker->close();
+    }
+
+private:
+    std::shared_ptr<loop> owner;
+    std::shared_ptr<async_handle> waker;
+    std::shared_ptr<run_queue> self;
+    std::mutex mutex;
+    details::scheduled_node *head;
+    details::scheduled_node *tail;
+    std::thread::id id;
+};
+
+/**
+ * @brief Sender that completes on the loop of a run queue.
+ *
+ * It completes inline when started on the thread of the loop.
+ */
+class schedule_sender {
+    template<typename Receiver>
+    class operation: private details::scheduled_node {
+        static void execute(details::scheduled_node *node) {
+            static_cast<operation *>(node)->receiver.set_value();
+        }
+
+    public:
+        operation(run_queue &ref, Receiver rcv)
+            : scheduled_node{&execute},
+              queue{ref},
+              receiver{std::move(rcv)} {}
+
+        operation(const operation &) = delete;
+        operation &operator=(const operation &) = delete;
+
+        void start() {
+            if(queue.running_in_this_thread()) {
+                receiver.set_value();
+            } else {
+                queue.post(*this);
+            }
+        }
+
+    private:
+        run_queue &queue;
+        Receiver receiver;
+    };
+
+public:
+    /*! @brief Type of the value sent on completion. */
+    using value_type = void;
+
+    explicit schedule_sender(run_queue &ref) noexcept
+        : queue{&ref} {}
+
+    /**
+     * @brief Connects the sender with a receiver.
+     * @tparam Receiver Type of receiver.
+     * @param receiver A receiver that offers `set_value` and `set_error`.
+     * @return An operation state, started with `start()`.
+     */
+    template<typename Receiver>
+    [[nodiscard]] operation<Receiver> connect(Receiver receiver) && {
+        return operation<Receiver>{*queue, std::move(receiver)};
+    }
+
+private:
+    run_queue *queue;
+};
+
+/**
+ * @brief The loop scheduler.
+ *
+ * A lightweight handle to a run queue that models a scheduler: `schedule()`
+ * returns a sender that completes on the loop thread.
+ *
+ * Senders are single-shot objects. A sender is connected to a receiver, that
+ * is an object with the member functions `set_value` (invoked with the value
+ * sent, if any) and `set_error` (invoked with an error event). The resulting
+ * operation state is started with `start()` and must outlive the completion.
+ * No algorithm in this header allocates, but the requests wrapped by
+ * `async_request` and `offload`.
+ */
+class loop_scheduler {
+public:
+    explicit loop_scheduler(run_queue &ref) noexcept
+        : queue{&ref} {}
+
+    /**
+     * @brief Returns a sender that completes on the loop thread.
+     * @return A sender that completes on the loop thread.
+     */
+    [[nodiscard]] schedule_sender schedule() const noexcept {
+        return schedule_sender{*queue};
+    }
+
+    /**
+     * @brief Gets the run queue of the scheduler.
+     * @return A reference to the run queue of the scheduler.
+     */
+    [[nodiscard]] run_queue &context() const noexcept {
+        return *queue;
+    }
+
+    [[nodiscard]] bool operator==(const loop_scheduler &other) const noexcept {
+        return (queue == other.queue);
+    }
+
+    [[nodiscard]] bool operator!=(const loop_scheduler &other) const noexcept {
+        return !(*this == other);
+    }
+
+private:
+    run_queue *queue;
+};
+
+inline loop_scheduler run_queue::scheduler() noexcept {
+    return loop_scheduler{*this};
+}
+
+/**
+ * @brief Sender that transforms the value of another sender.
+ * @tparam Sender Type of the input sender.
+ * @tparam Func Type of the function invoked with the value.
+ */
+template<typename Sender, typename Func>
+class then_sender {
+    using input_type = typename Sender::value_type;
+
+public:
+    /*! @brief Type of the value sent on completion. */
+    using value_type = typename details::invoke_value<Func, input_type>::type;
+
+private:
+    template<typename Receiver>
+    struct forward {
+        template<typename... Args>
+        void set_value(Args &&...args) {
+            if constexpr(std::is_void_v<value_type>) {
+                std::invoke(func, std::forward<Args>(args)...);
+                receiver.set_value();
+            } else {
+                receiver.set_value(std::invoke(func, std::forward<Args>(args)...));
+            }
+        }
+
+        void set_error(error_event event) {
+            receiver.set_error(event);
+        }
+
+        Func func;
+        Receiver receiver;
+    };
+
+public:
+    then_sender(Sender snd, Func fn)
+        : sender{std::move(snd)},
+          func{std::move(fn)} {}
+
+    /*! @copydoc schedule_sender::connect */
+    template<typename Receiver>
+    [[nodiscard]] auto connect(Receiver receiver) && {
+        return std::move(sender).connect(forward<Receiver>{std::move(func), std::move(receiver)});
+    }
+
+private:
+    Sender sender;
+    Func func;
+};
+
+/**
+ * @brief Sender that completes once all the given senders complete.
+ *
+ * The value sent is a tuple with the values of the senders, `std::monostate`
+ * for senders that don't send any value. In case of errors, the first one is
+ * sent once all the senders complete.
+ *
+ * @tparam Sender Types of the input senders.
+ */
+template<typename... Sender>
+class when_all_sender {
+public:
+    /*! @brief Type of the value sent on completion. */
+    using value_type = std::tuple<details::value_or_monostate_t<typename Sender::value_type>...>;
+
+private:
+    template<typename Receiver>
+    class operation {
+        template<std::size_t Index>
+        struct child {
+            template<typename... Args>
+            void set_value(Args &&...args) {
+                std::get<Index>(parent->values).emplace(std::forward<Args>(args)...);
+                parent->done();
+            }
+
+            void set_error(error_event event) {
+                parent->fail(event);
+            }
+
+            operation *parent;
+        };
+
+        template<std::size_t Index>
+        using child_type = decltype(std::declval<std::tuple_element_t<Index, std::tuple<Sender...>>>().connect(std::declval<child<Index>>()));
+
+        template<std::size_t Index, typename Op>
+        struct slot {
+            template<typename Func>
+            explicit slot(Func func)
+                : op(func()) {}
+
+            Op op;
+        };
+
+        template<typename>
+        struct children;
+
+        template<std::size_t... Index>
+        struct children<std::index_sequence<Index...>>: slot<Index, child_type<Index>>... {
+            children(operation *parent, std::tuple<Sender...> &senders)
+                : slot<Index, child_type<Index>>{[parent, &senders]() { return std::move(std::get<Index>(senders)).connect(child<Index>{parent}); }}... {}
+
+            void start() {
+                (slot<Index, child_type<Index>>::op.start(), ...);
+            }
+        };
+
+        void done() {
+            if(remaining.fetch_sub(1u, std::memory_order_acq_rel) == 1u) {
+                if(error) {
+                    receiver.set_error(*error);
+                } else {
+                    receiver.set_value(std::apply([](auto &...elem) { return value_type{std::move(*elem)...}; }, values));
+                }
+            }
+        }
+
+        void fail(error_event event) {
+            if(!failed.exchange(true, std::memory_order_acq_rel)) {
+                error.emplace(event);
+            }
+
+            done();
+        }
+
+    public:
+        operation(std::tuple<Sender...> &senders, Receiver rcv)
+            : receiver{std::move(rcv)},
+              values{},
+              error{},
+              failed{},
+              remaining{sizeof...(Sender) + 1u},
+              ops{this, senders} {}
+
+        operation(const operation &) = delete;
+        operation &operator=(const operation &) = delete;
+
+        void start() {
+            ops.start();
+            // the last reference is released once all the senders are started
+            done();
+        }
+
+    private:
+        Receiver receiver;
+        std::tuple<std::optional<details::value_or_monostate_t<typename Sender::value_type>>...> values;
+        std::optional<error_event> error;
+        std::atomic_bool failed;
+        std::atomic_size_t remaining;
+        children<std::index_sequence_for<Sender...>> ops;
+    };
+
+public:
+    explicit when_all_sender(Sender... snd)
+        : senders{std::move(snd)...} {}
+
+    /*! @copydoc schedule_sender::connect */
+    template<typename Receiver>
+    [[nodiscard]] operation<Receiver> connect(Receiver receiver) && {
+        return operation<Receiver>{senders, std::move(receiver)};
+    }
+
+private:
+    std::tuple<Sender...> senders;
+};
+
+/**
+ * @brief Sender that moves the completion of another sender to a scheduler.
+ *
+ * Useful to move between loops that run on different threads. It completes
+ * inline when the input sender completes on the thread of the target loop.
+ *
+ * @tparam Sender Type of the input sender.
+ */
+template<typename Sender>
+class continue_on_sender {
+public:
+    /*! @brief Type of the value sent on completion. */
+    using value_type = typename Sender::value_type;
+
+private:
+    template<typename Receiver>
+    class operation: private details::scheduled_node {
+        struct forward {
+            template<typename... Args>
+            void set_value(Args &&...args) {
+                parent->value.emplace(std::forward<Args>(args)...);
+                parent->hop();
+            }
+
+            void set_error(error_event event) {
+                parent->error.emplace(event);
+                parent->hop();
+            }
+
+            operation *parent;
+        };
+
+        using operation_type = decltype(std::declval<Sender>().connect(std::declval<forward>()));
+
+        static void execute(details::scheduled_node *node) {
+            static_cast<operation *>(node)->deliver();
+        }
+
+        void hop() {
+            if(queue.running_in_this_thread()) {
+                deliver();
+            } else {
+                queue.post(*this);
+            }
+        }
+
+        void deliver() {
+            if(error) {
+                receiver.set_error(*error);
+            } else {
+                details::set_value(receiver, value);
+            }
+        }
+
+    public:
+        operation(Sender &sender, run_queue &ref, Receiver rcv)
+            : scheduled_node{&execute},
+              queue{ref},
+              receiver{std::move(rcv)},
+              value{},
+              error{},
+              op{std::move(sender).connect(forward{this})} {}
+
+        operation(const operation &) = delete;
+        operation &operator=(const operation &) = delete;
+
+        void start() {
+            op.start();
+        }
+
+    private:
+        run_queue &queue;
+        Receiver receiver;
+        std::optional<details::value_or_monostate_t<value_type>> value;
+        std::optional<error_event> error;
+        operation_type op;
+    };
+
+public:
+    continue_on_sender(Sender snd, loop_scheduler sched)
+        : sender{std::move(snd)},
+          scheduler{sched} {}
+
+    /*! @copydoc schedule_sender::connect */
+    template<typename Receiver>
+    [[nodiscard]] operation<Receiver> connect(Receiver receiver) && {
+        return operation<Receiver>{sender, scheduler.context(), std::move(receiver)};
+    }
+
+private:
+    Sender sender;
+    loop_scheduler scheduler;
+};
+
+/**
+ * @brief Sender that runs a function on the threadpool.
+ *
+ * The request is submitted on the loop thread and the value returned by the
+ * function is sent on the loop thread.
+ *
+ * @tparam Func Type of the function.
+ */
+template<typename Func>
+class offload_sender {
+public:
+    /*! @brief Type of the value sent on completion. */
+    using value_type = std::invoke_result_t<Func &>;
+
+private:
+    template<typename Receiver>
+    class operation: private details::scheduled_node {
+        static void execute(details::scheduled_node *node) {
+            static_cast<operation *>(node)->submit();
+        }
+
+        void submit() {
+            req = queue.parent().resource<work_req>([this]() {
+                if constexpr(std::is_void_v<value_type>) {
+                    std::invoke(func);
+                    result.emplace();
+                } else {
+                    result.emplace(std::invoke(func));
+                }
+            });
+
+            req->on<work_event>([this](const work_event &, work_req &) {
+                details::set_value(receiver, result);
+            });
+
+            req->on<error_event>([this](const error_event &event, work_req &) {
+                receiver.set_error(event);
+            });
+
+            if(auto err = req->queue(); err != 0) {
+                req->reset();
+                receiver.set_error(error_event{err});
+            }
+        }
+
+    public:
+        operation(run_queue &ref, Func fn, Receiver rcv)
+            : scheduled_node{&execute},
+              queue{ref},
+              func{std::move(fn)},
+              receiver{std::move(rcv)},
+              result{},
+              req{} {}
+
+        operation(const operation &) = delete;
+        operation &operator=(const operation &) = delete;
+
+        void start() {
+            if(queue.running_in_this_thread()) {
+                submit();
+            } else {
+                queue.post(*this);
+            }
+        }
+
+    private:
+        run_queue &queue;
+        Func func;
+        Receiver receiver;
+        std::optional<details::value_or_monostate_t<value_type>> result;
+        std::shared_ptr<work_req> req;
+    };
+
+public:
+    offload_sender(loop_scheduler sched, Func fn)
+        : scheduler{sched},
+          func{std::move(fn)} {}
+
+    /*! @copydoc schedule_sender::connect */
+    template<typename Receiver>
+    [[nodiscard]] operation<Receiver> connect(Receiver receiver) && {
+        return operation<Receiver>{scheduler.context(), std::move(func), std::move(receiver)};
+    }
+
+private:
+    loop_scheduler scheduler;
+    Func func;
+};
+
+/**
+ * @brief Sender that wraps a request.
+ *
+ * The request is created and submitted on the loop thread and the event it
+ * emits on completion is sent as a value. The request is kept alive until the
+ * operation state is destroyed, so that events that refer to its memory are
+ * valid in the meantime.
+ *
+ * @tparam Type Type of the event emitted on completion.
+ * @tparam Request Type of the request.
+ * @tparam Func Type of the function that submits the request.
+ */
+template<typename Type, typename Request, typename Func>
+class request_sender {
+    using return_type = std::invoke_result_t<Func &, Request &>;
+
+    static_assert(std::is_void_v<return_type> || std::is_same_v<return_type, int>, "Invalid function type");
+
+public:
+    /*! @brief Type of the value sent on completion. */
+    using value_type = Type;
+
+private:
+    template<typename Receiver>
+    class operation: private details::scheduled_node {
+        static void execute(details::scheduled_node *node) {
+            static_cast<operation *>(node)->submit();
+        }
+
+        void submit() {
+            req = queue.parent().template resource<Request>();
+
+            req->template on<Type>([this](Type &event, Request &) {
+                receiver.set_value(std::move(event));
+            });
+
+            req->template on<error_event>([this](const error_event &event, Request &) {
+                receiver.set_error(event);
+            });
+
+            if constexpr(std::is_void_v<return_type>) {
+                std::invoke(func, *req);
+            } else if(auto err = std::invoke(func, *req); err != 0) {
+                req->reset();
+                receiver.set_error(error_event{err});
+            }
+        }
+
+    public:
+        operation(run_queue &ref, Func fn, Receiver rcv)
+            : scheduled_node{&execute},
+              queue{ref},
+              func{std::move(fn)},
+              receiver{std::move(rcv)},
+              req{} {}
+
+        operation(const operation &) = delete;
+        operation &operator=(const operation &) = delete;
+
+        void start() {
+            if(queue.running_in_this_thread()) {
+                submit();
+            } else {
+                queue.post(*this);
+            }
+        }
+
+    private:
+        run_queue &queue;
+        Func func;
+        Receiver receiver;
+        std::shared_ptr<Request> req;
+    };
+
+public:
+    request_sender(loop_scheduler sched, Func fn)
+        : scheduler{sched},
+          func{std::move(fn)} {}
+
+    /*! @copydoc schedule_sender::connect */
+    template<typename Receiver>
+    [[nodiscard]] operation<Receiver> connect(Receiver receiver) && {
+        return operation<Receiver>{scheduler.context(), std::move(func), std::move(receiver)};
+    }
+
+private:
+    loop_scheduler scheduler;
+    Func func;
+};
+
+/**
+ * @brief Connects a sender with a receiver.
+ * @tparam Sender Type of sender.
+ * @tparam Receiver Type of receiver.
+ * @param sender A sender, it's consumed by the function.
+ * @param receiver A receiver that offers `set_value` and `set_error`.
+ * @return An operation state, started with `start()`.
+ */
+template<typename Sender, typename Receiver>
+[[nodiscard]] auto connect(Sender &&sender, Receiver receiver) {
+    return std::move(sender).connect(std::move(receiver));
+}
+
+/**
+ * @brief Transforms the value of a sender.
+ * @tparam Sender Type of the input sender.
+ * @tparam Func Type of the function invoked with the value.
+ * @param sender The input sender.
+ * @param func The function invoked with the value, on the same thread.
+ * @return A sender for the value returned by the function.
+ */
+template<typename Sender, typename Func>
+[[nodiscard]] then_sender<Sender, Func> then(Sender sender, Func func) {
+    return then_sender<Sender, Func>{std::move(sender), std::move(func)};
+}
+
+/**
+ * @brief Waits for a group of senders to complete.
+ * @tparam Sender Types of the input senders.
+ * @param sender The input senders.
+ * @return A sender for a tuple with the values of the input senders.
+ */
+template<typename... Sender>
+[[nodiscard]] when_all_sender<Sender...> when_all(Sender... sender) {
+    return when_all_sender<Sender...>{std::move(sender)...};
+}
+
+/**
+ * @brief Moves the completion of a sender to a scheduler.
+ * @tparam Sender Type of the input sender.
+ * @param sender The input sender.
+ * @param scheduler The scheduler on which to complete.
+ * @return A sender that completes on the given scheduler.
+ */
+template<typename Sender>
+[[nodiscard]] continue_on_sender<Sender> continue_on(Sender sender, loop_scheduler scheduler) {
+    return continue_on_sender<Sender>{std::move(sender), scheduler};
+}
+
+/**
+ * @brief Runs a function on the threadpool.
+ * @tparam Func Type of the function.
+ * @param scheduler The scheduler on which to submit the work and complete.
+ * @param func The function to run on the threadpool.
+ * @return A sender for the value returned by the function.
+ */
+template<typename Func>
+[[nodiscard]] offload_sender<Func> offload(loop_scheduler scheduler, Func func) {
+    return offload_sender<Func>{scheduler, std::move(func)};
+}
+
+/**
+ * @brief Wraps a request in a sender.
+ *
+ * The function is invoked with the request as an argument and returns either
+ * nothing or the underlying return value of the operation. As an example:
+ *
+ * @code{.cpp}
+ * auto sender = uvw::async_request<uvw::fs_event, uvw::fs_req>(scheduler, [](auto &req) { req.stat("file"); });
+ * @endcode
+ *
+ * @tparam Type Type of the event emitted on completion.
+ * @tparam Request Type of the request.
+ * @tparam Func Type of the function that submits the request.
+ * @param scheduler The scheduler on which to submit the request and complete.
+ * @param func The function that submits the request.
+ * @return A sender for the event emitted on completion.
+ */
+template<typename Type, typename Request, typename Func>
+[[nodiscard]] request_sender<Type, Request, Func> async_request(loop_scheduler scheduler, Func func) {
+    return request_sender<Type, Request, Func>{scheduler, std::move(func)};
+}
+
+} // namespace uvw
+
+#endif // UVW_SCHEDULER_INCLUDE_H
@@ -0,0 +1,279 @@
+#ifndef UVW_SMALL_FUNCTION_INCLUDE_HPP
+#define UVW_SMALL_FUNCTION_INCLUDE_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "config.h"
+
+namespace uvw {
+
+/**
+ * @cond TURN_OFF_DOXYGEN
+ * Internal details not to be documented.
+ */
+
+namespace internal {
+
+template<typename>
+struct is_std_function: std::false_type {};
+
+template<typename Sig>
+struct is_std_function<std::function<Sig>>: std::true_type {};
+
+} // namespace internal
+
+/**
+ * Internal details not to be documented.
+ * @endcond
+ */
+
+/*! @brief Primary template isn't defined on purpose. */
+template<typename>
+class small_function;
+
+/**
+ * @brief Type-erased callable with inline storage.
+ *
+ * A drop-in replacement for `std::function` in the emitter hot paths.<br/>
+ * Callables that fit the internal buffer (as an example, lambdas that capture
+ * `this`, a couple of references or a `std::shared_ptr`) and are nothrow move
+ * constructible are stored in place, therefore binding them doesn't allocate.
+ * Larger callables are allocated on the heap.
+ *
+ * Invoking a small function is a single indirect call. Copying or moving
+ * trivially copyable callables is a plain copy of the internal buffer.
+ *
+ * @tparam Ret The return type of the callable.
+ * @tparam Args The types of the arguments of the callable.
+ */
+template<typename Ret, typename... Args>
+class small_function<Ret(Args...)> final {
+    static constexpr std::size_t BUFFER_SIZE = 2u * sizeof(void *);
+
+    struct vtable {
+        Ret (*invoke)(void *, Args...);
+        void (*copy)(void *, const void *);
+        void (*move)(void *, void *) noexcept;
+        void (*destroy)(void *) noexcept;
+    };
+
+    template<typename Func>
+    static constexpr bool is_inline_v = (sizeof(Func) <= BUFFER_SIZE) && (alignof(void *) % alignof(Func) == 0u) && std::is_nothrow_move_constructible_v<Func>;
+
+    template<typename Func>
+    [[nodiscard]] static Func *target(void *storage) noexcept {
+        if constexpr(is_inline_v<Func>) {
+            return std::launder(static_cast<Func *>(storage));
+        } else {
+            return *static_cast<Func **>(storage);
+        }
+    }
+
+    template<typename Func>
+    [[nodiscard]] static const Func *target(const void *storage) noexcept {
+        if constexpr(is_inline_v<Func>) {
+            return std::launder(static_cast<const Func *>(storage));
+        } else {
+            return *static_cast<Func *const *>(storage);
+        }
+    }
+
+    template<typename Func>
+    static Ret invoke(void *storage, Args... args) {
+        return static_cast<Ret>(std::invoke(*target<Func>(storage), std::forward<Args>(args)...));
+    }
+
+    template<typename Func>
+    static void copy(void *to, const void *from) {
+        if constexpr(is_inline_v<Func>) {
+            ::new(to) Func(*target<Func>(from));
+        } else {
+            *static_cast<Func **>(to) = new Func(*target<Func>(from));
+        }
+    }
+
+    template<typename Func>
+    static void move(void *to, void *from) noexcept {
+        ::new(to) Func(std::move(*target<Func>(from)));
+        target<Func>(from)->~Func();
+    }
+
+    template<typename Func>
+    static void destroy(void *storage) noexcept {
+        if constexpr(is_inline_v<Func>) {
+            target<Func>(storage)->~Func();
+        } else {
+            delete target<Func>(storage);
+        }
+    }
+
+    // null entries mean that a copy of the buffer is enough (or nothing at all, when destroying)
+    template<typename Func>
+    static constexpr vtable table{
+        &invoke<Func>,
+        (is_inline_v<Func> && std::is_trivially_copyable_v<Func>) ? nullptr : &copy<Func>,
+        (!is_inline_v<Func> || std::is_trivially_copyable_v<Func>) ? nullptr : &move<Func>,
+        (is_inline_v<Func> && std::is_trivially_destructible_v<Func>) ? nullptr : &destroy<Func>};
+
+    void release() noexcept {
+        if(vptr && vptr->destroy) {
+            vptr->destroy(storage);
+        }
+
+        vptr = nullptr;
+    }
+
+    void steal(small_function &other) noexcept {
+        vptr = std::exchange(other.vptr, nullptr);
+
+        if(vptr && vptr->move) {
+            vptr->move(storage, other.storage);
+        } else {
+            std::memcpy(storage, other.storage, BUFFER_SIZE);
+        }
+    }
+
+public:
+    /*! @brief Default constructor, the function is empty. */
+    small_function() noexcept = default;
+
+    /*! @brief Constructs an empty function. */
+    small_function(std::nullptr_t) noexcept
+        : small_function{} {}
+
+    /**
+     * @brief Constructs a function from a callable object.
+     *
+     * Null function pointers and empty `std::function`s result in an empty
+     * function.
+     *
+     * @tparam Func Type of the callable object.
+     * @param func A valid callable object.
+     */
+    template<typename Func, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Func>, small_function> && std::is_invocable_r_v<Ret, std::decay_t<Func> &, Args...>>>
+    small_function(Func &&func) {
+        using type = std::decay_t<Func>;
+
+        if constexpr(std::is_pointer_v<type> || std::is_member_pointer_v<type> || internal::is_std_function<type>::value) {
+            if(!func) {
+                return;
+            }
+        }
+
+        if constexpr(is_inline_v<type>) {
+            ::new(static_cast<void *>(storage)) type(std::forward<Func>(func));
+        } else {
+            *reinterpret_cast<type **>(storage) = new type(std::forward<Func>(func));
+        }
+
+        vptr = &table<type>;
+    }
+
+    /**
+     * @brief Copy constructor.
+     * @param other The function to copy from.
+     */
+    small_function(const small_function &other)
+        : vptr{other.vptr} {
+        if(vptr && vptr->copy) {
+            vptr->copy(storage, other.storage);
+        } else {
+            std::memcpy(storage, other.storage, BUFFER_SIZE);
+        }
+    }
+
+    /**
+     * @brief Move constructor.
+     * @param other The function to move from, left empty.
+     */
+    small_function(small_function &&other) noexcept {
+        steal(other);
+    }
+
+    /*! @brief Destructor. */
+    ~small_function() noexcept {
+        release();
+    }
+
+    /**
+     * @brief Copy assignment operator.
+     * @param other The function to copy from.
+     * @return This function.
+     */
+    small_function &operator=(const small_function &other) {
+        if(this != &other) {
+            *this = small_function{other};
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     * @param other The function to move from, left empty.
+     * @return This function.
+     */
+    small_function &operator=(small_function &&other) noexcept {
+        if(this != &other) {
+            release();
+            steal(other);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Empties the function.
+     * @return This function.
+     */
+    small_function &operator=(std::nullptr_t) noexcept {
+        release();
+        return *this;
+    }
+
+    /**
+     * @brief Invokes the underlying callable object.
+     * @param args The arguments to pass to the callable object.
+     * @return The value returned by the callable object.
+     */
+    Ret operator()(Args... args) const {
+        return vptr->invoke(storage, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Checks if the function contains a callable object.
+     * @return True if the function isn't empty, false otherwise.
+     */
+    [[nodiscard]] explicit operator bool() const noexcept {
+        return (vptr != nullptr);
+    }
+
+    /**
+     * @brief Gets the underlying callable object.
+     * @tparam Func Type of the callable object.
+     * @return A pointer to the callable object if it's of the given type, a
+     * null pointer otherwise.
+     */
+    template<typename Func>
+    [[nodiscard]] Func *target() noexcept {
+        return (vptr == &table<Func>) ? target<Func>(static_cast<void *>(storage)) : nullptr;
+    }
+
+    /*! @copydoc target */
+    template<typename Func>
+    [[nodiscard]] const Func *target() const noexcept {
+        return (vptr == &table<Func>) ? target<Func>(static_cast<const void *>(storage)) : nullptr;
+    }
+
+private:
+    alignas(void *) mutable std::byte storage[BUFFER_SIZE]{};
+    const vtable *vptr{};
+};
+
+} // namespace uvw
+
+#endif // UVW_SMALL_FUNCTION_INCLUDE_HPP
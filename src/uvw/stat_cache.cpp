@@ -0,0 +1,2 @@
+#include "stat_cache.h"
+#include "stat_cache.ipp"
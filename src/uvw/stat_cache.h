@@ -0,0 +1,160 @@
+#ifndef UVW_STAT_CACHE_INCLUDE_H
+#define UVW_STAT_CACHE_INCLUDE_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <uv.h>
+#include "config.h"
+#include "emitter.h"
+#include "fs.h"
+#include "fs_event.h"
+#include "loop.h"
+#include "util.h"
+
+namespace uvw {
+
+/*! @brief Stat cache event. */
+struct stat_cache_event {
+    std::string path; /*!< The path as passed to `stat_cache::stat`. */
+    file_info stat;   /*!< An initialized instance of file_info. */
+    bool hit;         /*!< True if served from the cache, false otherwise. */
+};
+
+/**
+ * @brief The stat cache.
+ *
+ * It memoizes the status of files by path, so that repeated requests for the
+ * same paths don't go through the threadpool.<br/>
+ * Cache hits complete synchronously, the event is emitted before `stat`
+ * returns. Misses are served by a `stat` on the threadpool and the result is
+ * cached on completion. Concurrent misses for the same path share the same
+ * request.
+ *
+ * Entries are invalidated as soon as their parent directories report a change
+ * through a `fs_event_handle`, one per directory. Watches don't keep the loop
+ * alive. Changes that directory watches cannot detect (as an example, to the
+ * targets of symbolic links or to the ancestors of the parent directories) are
+ * only caught when the entries expire.
+ *
+ * Errors are reported through error events and aren't cached.
+ *
+ * To create a `stat_cache` through a `loop`, no arguments are required.
+ */
+class stat_cache final: public emitter<stat_cache, stat_cache_event>, public std::enable_shared_from_this<stat_cache> {
+    struct record {
+        file_info stat;
+        loop::time expiry;
+        std::string dir;
+        std::string name;
+    };
+
+    struct watcher {
+        std::shared_ptr<fs_event_handle> handle;
+        std::unordered_multimap<std::string, std::string> names{};
+        std::size_t refs{};
+        std::size_t epoch{};
+    };
+
+    struct lookup {
+        std::shared_ptr<fs_req> req;
+        std::size_t count;
+    };
+
+    [[nodiscard]] static std::pair<std::string, std::string> split(const std::string &path);
+
+    bool acquire(const std::string &dir);
+    void release(const std::string &dir);
+    void erase(const std::string &path);
+    void changed(const std::string &dir, const char *name);
+    void complete(const std::string &path, const std::string &dir, const std::string &name, std::size_t epoch, const file_info *info, int err);
+
+public:
+    /*! @brief Default lifetime of the entries. */
+    static constexpr loop::time DEFAULT_TTL{1000};
+
+    explicit stat_cache(loop::token token, std::shared_ptr<loop> ref);
+
+    stat_cache(const stat_cache &) = delete;
+    stat_cache(stat_cache &&) = delete;
+
+    stat_cache &operator=(const stat_cache &) = delete;
+    stat_cache &operator=(stat_cache &&) = delete;
+
+    ~stat_cache() noexcept;
+
+    /**
+     * @brief Gets the loop from which the cache was originated.
+     * @return A reference to a loop instance.
+     */
+    [[nodiscard]] loop &parent() const noexcept;
+
+    /**
+     * @brief Sets the lifetime of the entries.
+     *
+     * It applies to the entries cached from now on. The default value is one
+     * second.
+     *
+     * @param value The lifetime of the entries, 0 to never expire them.
+     */
+    void ttl(loop::time value) noexcept;
+
+    /**
+     * @brief Gets the status of a file, possibly from the cache.
+     *
+     * A stat cache event is emitted synchronously in case of hits, once the
+     * [stat](http://linux.die.net/man/2/stat) completes otherwise.
+     *
+     * @param path Path, as described in the official documentation.
+     */
+    void stat(const std::string &path);
+
+    /**
+     * @brief Drops the entry of a path, if any.
+     *
+     * Requests in flight for the path aren't cached on completion.
+     *
+     * @param path Path, as described in the official documentation.
+     */
+    void invalidate(const std::string &path);
+
+    /*! @brief Drops all the entries and closes the watches no longer used. */
+    void clear();
+
+    /**
+     * @brief Gets the number of entries cached.
+     * @return The number of entries cached.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief Gets the number of requests served from the cache.
+     * @return The number of hits so far.
+     */
+    [[nodiscard]] std::size_t hits() const noexcept;
+
+    /**
+     * @brief Gets the number of requests that went through the threadpool.
+     * @return The number of misses so far.
+     */
+    [[nodiscard]] std::size_t misses() const noexcept;
+
+private:
+    std::shared_ptr<loop> owner;
+    std::unordered_map<std::string, record> entries;
+    std::unordered_map<std::string, watcher> watches;
+    std::unordered_map<std::string, lookup> inflight;
+    loop::time expiration;
+    std::size_t hit;
+    std::size_t miss;
+};
+
+} // namespace uvw
+
+#ifndef UVW_AS_LIB
+#    include "stat_cache.ipp"
+#endif
+
+#endif // UVW_STAT_CACHE_INCLUDE_H
@@ -0,0 +1,237 @@
+#include <utility>
+#include <vector>
+#include "config.h"
+
+namespace uvw {
+
+UVW_INLINE std::pair<std::string, std::string> stat_cache::split(const std::string &path) {
+#ifdef _WIN32
+    constexpr const char *separators = "/\\";
+#else
+    constexpr const char *separators = "/";
+#endif
+
+    const auto last = path.find_last_not_of(separators);
+
+    if(last == std::string::npos) {
+        // either the root directory or an empty path
+        return {path.empty() ? std::string{"."} : path.substr(0u, 1u), std::string{}};
+    }
+
+    const auto pos = path.find_last_of(separators, last);
+
+    if(pos == std::string::npos) {
+        return {std::string{"."}, path.substr(0u, last + 1u)};
+    }
+
+    const auto end = path.find_last_not_of(separators, pos);
+    std::string dir = (end == std::string::npos) ? path.substr(0u, 1u) : path.substr(0u, end + 1u);
+
+#ifdef _WIN32
+    if(dir.back() == ':') {
+        // drive roots keep their separator
+        dir += path[end + 1u];
+    }
+#endif
+
+    return {std::move(dir), path.substr(pos + 1u, last - pos)};
+}
+
+UVW_INLINE bool stat_cache::acquire(const std::string &dir) {
+    if(auto it = watches.find(dir); it != watches.end()) {
+        ++it->second.refs;
+        return true;
+    }
+
+    auto handle = owner->resource<fs_event_handle>();
+
+    if(!handle) {
+        return false;
+    }
+
+    handle->on<fs_event_event>([this, dir](const fs_event_event &event, fs_event_handle &) {
+        changed(dir, event.filename);
+    });
+
+    handle->on<error_event>([this, dir](const error_event &, fs_event_handle &) {
+        changed(dir, nullptr);
+    });
+
+    if(handle->start(dir) != 0) {
+        handle->close();
+        return false;
+    }
+
+    handle->unreference();
+    watches.emplace(dir, watcher{std::move(handle), {}, 1u});
+
+    return true;
+}
+
+UVW_INLINE void stat_cache::release(const std::string &dir) {
+    if(auto it = watches.find(dir); it != watches.end() && --it->second.refs == 0u) {
+        it->second.handle->close();
+        watches.erase(it);
+    }
+}
+
+UVW_INLINE void stat_cache::erase(const std::string &path) {
+    if(auto it = entries.find(path); it != entries.end()) {
+        auto node = entries.extract(it);
+        auto &curr = node.mapped();
+
+        if(auto elem = watches.find(curr.dir); elem != watches.end()) {
+            auto [first, last] = elem->second.names.equal_range(curr.name);
+
+            for(; first != last; ++first) {
+                if(first->second == path) {
+                    elem->second.names.erase(first);
+                    break;
+                }
+            }
+        }
+
+        release(curr.dir);
+    }
+}
+
+UVW_INLINE void stat_cache::changed(const std::string &dir, const char *name) {
+    if(auto it = watches.find(dir); it != watches.end()) {
+        auto &curr = it->second;
+        std::vector<std::string> paths{};
+
+        // results of the requests in flight may predate the change
+        ++curr.epoch;
+
+        if(!name || !*name || split(dir).second == name) {
+            // changes to the directory itself affect all its entries
+            for(auto &&elem: curr.names) {
+                paths.push_back(elem.second);
+            }
+        } else {
+            for(auto [first, last] = curr.names.equal_range(name); first != last; ++first) {
+                paths.push_back(first->second);
+            }
+        }
+
+        for(auto &&path: paths) {
+            erase(path);
+        }
+    }
+}
+
+UVW_INLINE void stat_cache::complete(const std::string &path, const std::string &dir, const std::string &name, std::size_t epoch, const file_info *info, int err) {
+    // the request is released once done, the caller holds a reference to it
+    const auto count = inflight.extract(path).mapped().count;
+
+    // an empty directory marks the requests whose results cannot be cached
+    if(!dir.empty()) {
+        if(auto &curr = watches[dir]; info && curr.epoch == epoch) {
+            // the reference to the watch moves to the entry
+            curr.names.emplace(name, path);
+            entries.emplace(path, record{*info, expiration.count() ? (owner->now() + expiration) : loop::time::max(), dir, name});
+        } else {
+            release(dir);
+        }
+    }
+
+    for(std::size_t pos{}; pos < count; ++pos) {
+        if(info) {
+            publish(stat_cache_event{path, *info, false});
+        } else {
+            publish(error_event{err});
+        }
+    }
+}
+
+UVW_INLINE stat_cache::stat_cache(loop::token, std::shared_ptr<loop> ref)
+    : owner{std::move(ref)},
+      entries{},
+      watches{},
+      inflight{},
+      expiration{DEFAULT_TTL},
+      hit{},
+      miss{} {}
+
+UVW_INLINE stat_cache::~stat_cache() noexcept {
+    for(auto &&elem: watches) {
+        elem.second.handle->close();
+    }
+}
+
+UVW_INLINE loop &stat_cache::parent() const noexcept {
+    return *owner;
+}
+
+UVW_INLINE void stat_cache::ttl(loop::time value) noexcept {
+    expiration = value;
+}
+
+UVW_INLINE void stat_cache::stat(const std::string &path) {
+    if(auto it = entries.find(path); it != entries.end()) {
+        if(owner->now() < it->second.expiry) {
+            ++hit;
+            publish(stat_cache_event{path, it->second.stat, true});
+            return;
+        }
+
+        erase(path);
+    }
+
+    ++miss;
+
+    if(auto it = inflight.find(path); it != inflight.end()) {
+        ++it->second.count;
+        return;
+    }
+
+    auto parts = split(path);
+    const bool watched = acquire(parts.first);
+    const auto epoch = watched ? watches[parts.first].epoch : std::size_t{};
+    auto req = owner->resource<fs_req>();
+
+    req->on<fs_event>([ptr = shared_from_this(), path, dir = watched ? parts.first : std::string{}, name = parts.second, epoch](const fs_event &event, fs_req &) {
+        ptr->complete(path, dir, name, epoch, &event.stat, 0);
+    });
+
+    req->on<error_event>([ptr = shared_from_this(), path, dir = watched ? parts.first : std::string{}, name = parts.second, epoch](const error_event &event, fs_req &) {
+        ptr->complete(path, dir, name, epoch, nullptr, event.code());
+    });
+
+    req->stat(path);
+    inflight.emplace(path, lookup{std::move(req), 1u});
+}
+
+UVW_INLINE void stat_cache::invalidate(const std::string &path) {
+    if(inflight.count(path) != 0u) {
+        if(auto it = watches.find(split(path).first); it != watches.end()) {
+            ++it->second.epoch;
+        }
+    }
+
+    erase(path);
+}
+
+UVW_INLINE void stat_cache::clear() {
+    for(auto &&elem: watches) {
+        ++elem.second.epoch;
+    }
+
+    while(!entries.empty()) {
+        erase(entries.begin()->first);
+    }
+}
+
+UVW_INLINE std::size_t stat_cache::size() const noexcept {
+    return entries.size();
+}
+
+UVW_INLINE std::size_t stat_cache::hits() const noexcept {
+    return hit;
+}
+
+UVW_INLINE std::size_t stat_cache::misses() const noexcept {
+    return miss;
+}
+
+} // namespace uvw
@@ -4,17 +4,34 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <memory>
+#include <string>
+#include <type_traits>
 #include <utility>
+#include <vector>
 #include <uv.h>
+#include "check.h"
 #include "config.h"
 #include "handle.hpp"
 #include "loop.h"
+#include "pool.h"
 #include "request.hpp"
+#include "timer_wheel.h"
 
 namespace uvw {
 
+namespace details {
+
+enum class uvw_timeout_type : std::uint8_t {
+    READ,
+    WRITE,
+    LIFETIME
+};
+
+}
+
 /*! @brief Connect event. */
 struct connect_event {};
 
@@ -30,12 +47,59 @@ struct shutdown_event {};
 /*! @brief Write event. */
 struct write_event {};
 
-/*! @brief Data event. */
+/*! @brief Send file progress event. */
+struct send_file_progress_event {
+    std::size_t sent;   /*!< The amount of data sent so far. */
+    std::size_t length; /*!< The amount of data requested. */
+};
+
+/*! @brief Send file event. */
+struct send_file_event {
+    std::size_t sent; /*!< The amount of data sent, less than requested if the end of the file has been reached. */
+};
+
+/**
+ * @brief Timeout event.
+ *
+ * It will be emitted by stream handles when a deadline expires.
+ */
+struct timeout_event {
+    details::uvw_timeout_type type; /*!< The deadline that expired. */
+};
+
+/**
+ * @brief Pressure event.
+ *
+ * It will be emitted by stream handles when the write queue reaches the high
+ * watermark.
+ */
+struct pressure_event {
+    std::size_t queued; /*!< The amount of data waiting to be sent. */
+};
+
+/**
+ * @brief Drain event.
+ *
+ * It will be emitted by stream handles under pressure when the write queue
+ * falls to the low watermark.
+ */
+struct drain_event {
+    std::size_t queued; /*!< The amount of data waiting to be sent. */
+};
+
+/**
+ * @brief Data event.
+ *
+ * @note
+ * Unless a custom allocation function is used, data come from the pool of the
+ * loop and must be released on the thread that runs the loop. Copy the data
+ * or move them back to the loop before releasing them elsewhere.
+ */
 struct data_event {
-    explicit data_event(std::unique_ptr<char[]> buf, std::size_t len) noexcept;
+    explicit data_event(std::unique_ptr<char[], buffer_deleter> buf, std::size_t len) noexcept;
 
-    std::unique_ptr<char[]> data; /*!< A bunch of data read on the stream. */
-    std::size_t length;           /*!< The amount of data read on the stream. */
+    std::unique_ptr<char[], buffer_deleter> data; /*!< A bunch of data read on the stream. */
+    std::size_t length;                           /*!< The amount of data read on the stream. */
 };
 
 namespace details {
@@ -58,6 +122,38 @@ public:
     }
 };
 
+struct stream_timeouts {
+    ~stream_timeouts() noexcept;
+
+    std::shared_ptr<timer_wheel> wheel;
+    std::array<timer_wheel::time, 3u> duration;
+    std::array<timer_token, 3u> token;
+};
+
+struct stream_backpressure {
+    ~stream_backpressure() noexcept;
+
+    std::size_t high;
+    std::size_t low;
+    std::weak_ptr<void> source;
+    void (*throttle)(stream_backpressure &, bool);
+    uv_alloc_cb alloc;
+    uv_read_cb read;
+    bool pressure;
+};
+
+struct stream_writer {
+    ~stream_writer() noexcept;
+
+    std::shared_ptr<check_handle> hook;
+    std::unique_ptr<char[], buffer_deleter> data;
+    std::size_t length;
+    std::size_t threshold;
+    std::size_t writes;
+    std::size_t completed;
+    bool eager;
+};
+
 class shutdown_req final: public request<shutdown_req, uv_shutdown_t, shutdown_event> {
     static void shoutdown_callback(uv_shutdown_t *req, int status);
 
@@ -67,6 +163,48 @@ public:
     int shutdown(uv_stream_t *hndl);
 };
 
+class send_file_req final: public request<send_file_req, uv_fs_t, send_file_progress_event, send_file_event> {
+    // upper bound to the data sent at once, progress is reported at least this often
+    static constexpr std::size_t SEND_CHUNK = 1u << 20u;
+    static constexpr std::size_t COPY_CHUNK = 1u << 16u;
+
+    static void fs_send_callback(uv_fs_t *req);
+    static void write_callback(uv_write_t *req, int status);
+
+    [[nodiscard]] std::size_t window() const noexcept;
+
+    int step();
+    void progress(std::size_t len);
+    void advance();
+    void finish(int err);
+
+public:
+    send_file_req(loop::token token, std::shared_ptr<loop> parent, uv_stream_t *hndl, uv_file file, int64_t offset, std::size_t length);
+
+    ~send_file_req() noexcept override;
+
+    int send();
+    int send(const std::string &path);
+    void cancel() noexcept;
+
+private:
+    std::unique_ptr<char[], buffer_deleter> data;
+    uv_write_t writer;
+    uv_stream_t *target;
+    uv_file out;
+    uv_file in;
+    int64_t position;
+    std::size_t remaining;
+    std::size_t total;
+    std::size_t sent;
+    int status;
+    bool zero_copy;
+    bool owned;
+    bool stalled;
+    bool sending;
+    bool cancelled;
+};
+
 template<typename Deleter>
 class write_req final: public request<write_req<Deleter>, uv_write_t, write_event> {
     static void write_callback(uv_write_t *req, int status) {
@@ -78,10 +216,10 @@ class write_req final: public request<write_req<Deleter>, uv_write_t, write_even
     }
 
 public:
-    write_req(loop::token token, std::shared_ptr<loop> parent, std::unique_ptr<char[], Deleter> dt, unsigned int len)
+    write_req(loop::token token, std::shared_ptr<loop> parent, std::unique_ptr<char[], Deleter> dt, unsigned int len, unsigned int offset = 0u)
         : request<write_req<Deleter>, uv_write_t, write_event>{token, std::move(parent)},
           data{std::move(dt)},
-          buf{uv_buf_init(data.get(), len)} {}
+          buf{uv_buf_init(data.get() + offset, len - offset)} {}
 
     int write(uv_stream_t *hndl) {
         return this->leak_if(uv_write(this->raw(), hndl, &buf, 1, &write_callback));
@@ -96,6 +234,103 @@ private:
     uv_buf_t buf;
 };
 
+template<typename Deleter>
+class writev_req final: public request<writev_req<Deleter>, uv_write_t, write_event> {
+    static void write_callback(uv_write_t *req, int status) {
+        if(auto ptr = request<writev_req<Deleter>, uv_write_t, write_event>::reserve(req); status) {
+            ptr->publish(error_event{status});
+        } else {
+            ptr->publish(write_event{});
+        }
+    }
+
+public:
+    using buffers = std::vector<std::pair<std::unique_ptr<char[], Deleter>, unsigned int>>;
+
+    writev_req(loop::token token, std::shared_ptr<loop> parent, buffers dt = {})
+        : request<writev_req<Deleter>, uv_write_t, write_event>{token, std::move(parent)},
+          data{std::move(dt)},
+          views{pool_allocator<uv_buf_t>{this->parent().buffers()}} {
+        views.reserve(data.size());
+
+        for(auto &&[chunk, len]: data) {
+            views.push_back(uv_buf_init(chunk.get(), len));
+        }
+    }
+
+    void assign(const uv_buf_t bufs[], unsigned int nbufs) {
+        // borrowed buffers, the request doesn't own the data
+        views.assign(bufs, bufs + nbufs);
+    }
+
+    void consume(std::size_t bytes) noexcept {
+        // buffers already sent are dropped, the first one left may be sent in part
+        auto first = views.begin();
+
+        for(; bytes && first != views.end() && bytes >= first->len; ++first) {
+            bytes -= first->len;
+        }
+
+        views.erase(views.begin(), first);
+
+        if(bytes) {
+            views.front().base += bytes;
+            views.front().len -= static_cast<decltype(uv_buf_t::len)>(bytes);
+        }
+    }
+
+    int write(uv_stream_t *hndl) {
+        return write(hndl, views.data(), static_cast<unsigned int>(views.size()));
+    }
+
+    int write(uv_stream_t *hndl, uv_stream_t *send) {
+        return write(hndl, views.data(), static_cast<unsigned int>(views.size()), send);
+    }
+
+    int write(uv_stream_t *hndl, const uv_buf_t bufs[], unsigned int nbufs) {
+        // libuv asserts on empty sequences of buffers
+        return nbufs ? this->leak_if(uv_write(this->raw(), hndl, bufs, nbufs, &write_callback)) : UV_EINVAL;
+    }
+
+    int write(uv_stream_t *hndl, const uv_buf_t bufs[], unsigned int nbufs, uv_stream_t *send) {
+        return nbufs ? this->leak_if(uv_write2(this->raw(), hndl, bufs, nbufs, send, &write_callback)) : UV_EINVAL;
+    }
+
+private:
+    buffers data;
+    std::vector<uv_buf_t, pool_allocator<uv_buf_t>> views;
+};
+
+[[nodiscard]] inline uv_buf_t view_of(const uv_buf_t &buf) noexcept {
+    return buf;
+}
+
+template<typename Deleter>
+[[nodiscard]] uv_buf_t view_of(const std::pair<std::unique_ptr<char[], Deleter>, unsigned int> &elem) noexcept {
+    return uv_buf_init(elem.first.get(), elem.second);
+}
+
+template<typename Bufs>
+[[nodiscard]] std::size_t total_of(const Bufs &bufs) noexcept {
+    std::size_t total{};
+
+    for(auto &&elem: bufs) {
+        total += view_of(elem).len;
+    }
+
+    return total;
+}
+
+template<typename, typename = void>
+struct is_buffer_sequence: std::false_type {};
+
+template<typename Type>
+struct is_buffer_sequence<Type, std::void_t<decltype(std::data(std::declval<const Type &>())), decltype(std::size(std::declval<const Type &>()))>>
+    : std::is_same<std::remove_cv_t<std::remove_pointer_t<decltype(std::data(std::declval<const Type &>()))>>, uv_buf_t> {};
+
+template<typename Type>
+inline constexpr bool is_buffer_sequence_v = is_buffer_sequence<Type>::value;
+
 } // namespace details
 
 /**
@@ -106,43 +341,318 @@ private:
  * implementations: tcp, pipe and tty handles.
  */
 template<typename T, typename U, typename... E>
-class stream_handle: public handle<T, U, listen_event, end_event, connect_event, shutdown_event, data_event, write_event, E...> {
-    using base = handle<T, U, listen_event, end_event, connect_event, shutdown_event, data_event, write_event, E...>;
+class stream_handle: public handle<T, U, listen_event, end_event, connect_event, shutdown_event, data_event, write_event, send_file_progress_event, send_file_event, timeout_event, pressure_event, drain_event, E...> {
+    using base = handle<T, U, listen_event, end_event, connect_event, shutdown_event, data_event, write_event, send_file_progress_event, send_file_event, timeout_event, pressure_event, drain_event, E...>;
 
     template<typename, typename, typename...>
     friend class stream_handle;
 
+    friend base;
+
     static constexpr unsigned int DEFAULT_BACKLOG = 128;
+    static constexpr std::size_t DEFAULT_CORK_THRESHOLD = 1u << 14u;
 
+    template<bool Pooled, typename Handler = void>
     static void read_callback(uv_stream_t *hndl, ssize_t nread, const uv_buf_t *buf) {
         T &ref = *(static_cast<T *>(hndl->data));
-        // data will be destroyed no matter of what the value of nread is
-        std::unique_ptr<char[]> data{buf->base};
+        // data will be destroyed (or given back to the pool) no matter of what the value of nread is
+        std::unique_ptr<char[], buffer_deleter> data{buf->base, buffer_deleter{Pooled}};
 
         // nread == 0 is ignored (see http://docs.libuv.org/en/v1.x/stream.html)
         // equivalent to EAGAIN/EWOULDBLOCK, it shouldn't be treated as an error
         // for we don't have data to emit though, it's fine to suppress it
 
+        if(nread > 0) {
+            ref.restart(timeout_type::READ);
+        } else if(nread < 0) {
+            ref.cancel(timeout_type::READ);
+        }
+
         if(nread == UV_EOF) {
             // end of stream
-            ref.publish(end_event{});
+            ref.template dispatch<Handler>(end_event{});
         } else if(nread > 0) {
             // data available
-            ref.publish(data_event{std::move(data), static_cast<std::size_t>(nread)});
+            ref.template dispatch<Handler>(data_event{std::move(data), static_cast<std::size_t>(nread)});
         } else if(nread < 0) {
             // transmission error
-            ref.publish(error_event(nread));
+            ref.template dispatch<Handler>(error_event(nread));
         }
     }
 
+    template<typename Handler = void>
     static void listen_callback(uv_stream_t *hndl, int status) {
         if(T &ref = *(static_cast<T *>(hndl->data)); status) {
-            ref.publish(error_event{status});
+            ref.template dispatch<Handler>(error_event{status});
         } else {
-            ref.publish(listen_event{});
+            ref.template dispatch<Handler>(listen_event{});
         }
     }
 
+    static void timeout_callback(void *data, timer_token tkn) {
+        auto &ref = *static_cast<stream_handle *>(data);
+        auto &token = ref.deadlines->token;
+
+        if(const auto pos = static_cast<std::size_t>(std::find(token.begin(), token.end(), tkn) - token.begin()); pos < token.size()) {
+            token[pos] = timer_token{};
+
+            if(!ref.closing()) {
+                ref.publish(timeout_event{static_cast<timeout_type>(pos)});
+            }
+        }
+    }
+
+    void restart(details::uvw_timeout_type type) {
+        if(deadlines) {
+            const auto pos = static_cast<std::size_t>(type);
+            auto &&[wheel, duration, token] = *deadlines;
+
+            if(duration[pos].count() == 0u) {
+                wheel->stop(std::exchange(token[pos], timer_token{}));
+            } else if(!wheel->again(token[pos], duration[pos])) {
+                token[pos] = wheel->start(duration[pos], &timeout_callback, this);
+            }
+        }
+    }
+
+    void cancel(details::uvw_timeout_type type) noexcept {
+        if(deadlines) {
+            deadlines->wheel->stop(std::exchange(deadlines->token[static_cast<std::size_t>(type)], timer_token{}));
+        }
+    }
+
+    template<typename S>
+    static void throttle(details::stream_backpressure &state, bool enable) {
+        if(auto source = std::static_pointer_cast<S>(state.source.lock()); source) {
+            if(auto *curr = source->as_uv_stream(); enable) {
+                if(curr->read_cb) {
+                    // callbacks are reset when reading stops, whatever they are
+                    state.alloc = curr->alloc_cb;
+                    state.read = curr->read_cb;
+                    source->stop();
+                }
+            } else if(state.read) {
+                source->reading(uv_read_start(curr, std::exchange(state.alloc, nullptr), std::exchange(state.read, nullptr)));
+            }
+        }
+    }
+
+    void pressure(bool enable) {
+        if(backpressure && backpressure->pressure != enable) {
+            const auto queued = write_queue_size();
+
+            if(enable ? (backpressure->high && queued >= backpressure->high) : (queued <= backpressure->low)) {
+                backpressure->pressure = enable;
+
+                if(backpressure->throttle) {
+                    backpressure->throttle(*backpressure, enable);
+                }
+
+                if(enable) {
+                    this->publish(pressure_event{queued});
+                } else {
+                    this->publish(drain_event{queued});
+                }
+            }
+        }
+    }
+
+    bool renew_hook() {
+        auto hook = this->parent().template resource<check_handle>();
+
+        if(!hook) {
+            return false;
+        }
+
+        hook->template on<check_event>([this](const check_event &, check_handle &) { deferred(); });
+        writer->hook = std::move(hook);
+
+        return true;
+    }
+
+    bool acquire_writer() {
+        if(!writer) {
+            writer = std::make_unique<details::stream_writer>();
+
+            if(!renew_hook()) {
+                writer.reset();
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    int wake() {
+        // the hook is a plain handle, walking the loop may have closed it
+        if(writer->hook->closing() && !renew_hook()) {
+            return UV_ENOMEM;
+        }
+
+        return writer->hook->start();
+    }
+
+    void deferred() {
+        flush();
+
+        if(this->closing()) {
+            // the hook goes along with the stream
+            writer->hook->close();
+        } else {
+            writer->hook->stop();
+        }
+
+        for(auto next = std::exchange(writer->completed, 0u); next; --next) {
+            this->publish(write_event{});
+        }
+    }
+
+    template<typename Bufs>
+    bool gather(const Bufs &bufs) {
+        if(!writer || !writer->threshold) {
+            return false;
+        }
+
+        const auto total = details::total_of(bufs);
+
+        if(total == 0u || total >= writer->threshold) {
+            // large writes aren't worth a copy, they follow gathered data
+            flush();
+            return false;
+        }
+
+        if(writer->length + total > writer->threshold) {
+            flush();
+        }
+
+        if(!writer->data) {
+            writer->data = this->parent().buffers().acquire(writer->threshold);
+        }
+
+        if(!writer->length) {
+            wake();
+        }
+
+        for(auto &&elem: bufs) {
+            const auto buf = details::view_of(elem);
+            std::copy_n(buf.base, buf.len, writer->data.get() + writer->length);
+            writer->length += buf.len;
+        }
+
+        ++writer->writes;
+
+        if(writer->length == writer->threshold) {
+            flush();
+        }
+
+        return true;
+    }
+
+    template<typename Bufs>
+    std::size_t attempt(const Bufs &bufs) {
+        // data can't skip the line, nor can their write events
+        if(!writer || !writer->eager || requests || write_queue_size()) {
+            return 0u;
+        }
+
+        int sent{};
+
+        if constexpr(details::is_buffer_sequence_v<Bufs>) {
+            sent = std::size(bufs) ? uv_try_write(as_uv_stream(), std::data(bufs), static_cast<unsigned int>(std::size(bufs))) : 0;
+        } else {
+            std::vector<uv_buf_t, details::pool_allocator<uv_buf_t>> views{details::pool_allocator<uv_buf_t>{this->parent().buffers()}};
+            views.reserve(bufs.size());
+
+            for(auto &&elem: bufs) {
+                views.push_back(details::view_of(elem));
+            }
+
+            sent = views.empty() ? 0 : uv_try_write(as_uv_stream(), views.data(), static_cast<unsigned int>(views.size()));
+        }
+
+        // errors are reported by the regular write path
+        return sent > 0 ? static_cast<std::size_t>(sent) : 0u;
+    }
+
+    int complete(std::size_t count) {
+        // write events are never emitted from within a write
+        writer->completed += count;
+        return wake();
+    }
+
+    template<typename Handler, typename R, typename... Args>
+    int submit(std::shared_ptr<R> req, Args... args) {
+        // data gathered so far go first
+        flush();
+        return submit<Handler>(1u, std::move(req), args...);
+    }
+
+    template<typename Handler, typename R, typename... Args>
+    int submit(std::size_t count, std::shared_ptr<R> req, Args... args) {
+        // writes completed synchronously so far are notified before this one
+        const auto done = writer ? std::exchange(writer->completed, 0u) : std::size_t{};
+
+        // pending requests complete before the close callback, a raw pointer to the handle and
+        // narrower counters are enough and keep the listeners within the small function buffer
+        auto listener = [ptr = this, count = static_cast<std::uint32_t>(count), done = static_cast<std::uint32_t>(done)](const auto &event, const auto &) {
+            --ptr->requests;
+
+            if(ptr->write_queue_size() == 0u) {
+                ptr->cancel(timeout_type::WRITE);
+            } else {
+                ptr->restart(timeout_type::WRITE);
+            }
+
+            ptr->pressure(false);
+
+            for(auto next = done; next; --next) {
+                ptr->publish(write_event{});
+            }
+
+            // gathered writes are notified one by one
+            for(auto next = count; next; --next) {
+                ptr->template dispatch<Handler>(event);
+            }
+        };
+
+        req->template on<error_event>(listener);
+        req->template on<write_event>(listener);
+
+        const auto err = req->write(args...);
+
+        if(err == 0) {
+            ++requests;
+        } else if(done) {
+            writer->completed += done;
+        }
+
+        if(err == 0 && write_queue_size() != 0u && deadlines && !deadlines->wheel->active(deadlines->token[static_cast<std::size_t>(timeout_type::WRITE)])) {
+            // data that don't fit the socket buffer are stalled until writable
+            restart(timeout_type::WRITE);
+        }
+
+        pressure(true);
+
+        return err;
+    }
+
+    int reading(int err) {
+        if(err == 0) {
+            restart(timeout_type::READ);
+        }
+
+        return err;
+    }
+
+    int track(const std::shared_ptr<details::send_file_req> &req, int err) {
+        if(err == 0) {
+            transfers.erase(std::remove_if(transfers.begin(), transfers.end(), [](const auto &curr) { return curr.expired(); }), transfers.end());
+            transfers.push_back(req);
+        }
+
+        return err;
+    }
+
     [[nodiscard]] uv_stream_t *as_uv_stream() {
         return reinterpret_cast<uv_stream_t *>(this->raw());
     }
@@ -151,7 +661,34 @@ class stream_handle: public handle<T, U, listen_event, end_event, connect_event,
         return reinterpret_cast<const uv_stream_t *>(this->raw());
     }
 
+    void before_close() {
+        // gathered data are written like any other write already submitted
+        flush();
+        detach();
+    }
+
+protected:
+    void detach() {
+        if(writer) {
+            // the hook is closed once the writes completed so far are notified
+            if(writer->completed) {
+                wake();
+            } else {
+                writer->hook->close();
+            }
+        }
+
+        // transfers on the threadpool let go of the socket as soon as possible
+        for(auto &&curr: std::exchange(transfers, {})) {
+            if(auto req = curr.lock(); req) {
+                req->cancel();
+            }
+        }
+    }
+
 public:
+    using timeout_type = details::uvw_timeout_type;
+
 #ifdef _MSC_VER
     stream_handle(loop::token token, std::shared_ptr<loop> ref)
         : base{token, std::move(ref)} {}
@@ -169,11 +706,15 @@ public:
      * @return Underlying return value.
      */
     int shutdown() {
-        auto listener = [ptr = this->shared_from_this()](const auto &event, const auto &) {
+        flush();
+
+        // pending requests complete before the close callback, a raw pointer
+        // to the handle is enough and doesn't allocate within the listeners
+        auto listener = [ptr = this](const auto &event, const auto &) {
             ptr->publish(event);
         };
 
-        auto shutdown = this->parent().template resource<details::shutdown_req>();
+        auto shutdown = this->parent().template recycled_resource<details::shutdown_req>();
         shutdown->template on<error_event>(listener);
         shutdown->template on<shutdown_event>(listener);
 
@@ -192,7 +733,20 @@ public:
      * @return Underlying return value.
      */
     int listen(int backlog = DEFAULT_BACKLOG) {
-        return uv_listen(as_uv_stream(), backlog, &listen_callback);
+        return uv_listen(as_uv_stream(), backlog, &listen_callback<>);
+    }
+
+    /**
+     * @brief Starts listening for incoming connections.
+     * @sa listen
+     * @tparam Handler Type to which listen events are dispatched.
+     * @param backlog Indicates the number of connections the kernel might
+     * queue, same as listen(2).
+     * @return Underlying return value.
+     */
+    template<typename Handler>
+    int listen(static_handler<Handler>, int backlog = DEFAULT_BACKLOG) {
+        return uv_listen(as_uv_stream(), backlog, &listen_callback<Handler>);
     }
 
     /**
@@ -226,10 +780,14 @@ public:
      * read or `stop()` is called.<br/>
      * An end event will be emitted when there is no more data to read.
      *
+     * Buffers are taken from the pool of the loop (see `loop::buffers()`) and
+     * given back to it when data events are destroyed. Therefore, data events
+     * must be destroyed on the thread that runs the loop.
+     *
      * @return Underlying return value.
      */
     int read() {
-        return uv_read_start(as_uv_stream(), &details::common_alloc_callback, &read_callback);
+        return reading(uv_read_start(as_uv_stream(), &details::pool_alloc_callback<T>, &read_callback<true>));
     }
 
     /**
@@ -240,7 +798,18 @@ public:
      */
     template<auto Alloc>
     int read() {
-        return uv_read_start(as_uv_stream(), &details::common_alloc_callback<T, Alloc>, &read_callback);
+        return reading(uv_read_start(as_uv_stream(), &details::common_alloc_callback<T, Alloc>, &read_callback<false>));
+    }
+
+    /**
+     * @brief Starts reading data from an incoming stream.
+     * @sa read
+     * @tparam Handler Type to which data, end and error events are dispatched.
+     * @return Underlying return value.
+     */
+    template<typename Handler>
+    int read(static_handler<Handler>) {
+        return reading(uv_read_start(as_uv_stream(), &details::pool_alloc_callback<T>, &read_callback<true, Handler>));
     }
 
     /**
@@ -251,6 +820,7 @@ public:
      * @return Underlying return value.
      */
     int stop() {
+        cancel(timeout_type::READ);
         return uv_read_stop(as_uv_stream());
     }
 
@@ -268,15 +838,20 @@ public:
      */
     template<typename Deleter>
     int write(std::unique_ptr<char[], Deleter> data, unsigned int len) {
-        auto req = this->parent().template resource<details::write_req<Deleter>>(std::move(data), len);
-        auto listener = [ptr = this->shared_from_this()](const auto &event, const auto &) {
-            ptr->publish(event);
-        };
+        const std::array bufs{uv_buf_init(data.get(), len)};
 
-        req->template on<error_event>(listener);
-        req->template on<write_event>(listener);
+        if(gather(bufs)) {
+            return 0;
+        }
+
+        const auto sent = static_cast<unsigned int>(attempt(bufs));
+
+        if(sent && sent == len) {
+            return complete(1u);
+        }
 
-        return req->write(as_uv_stream());
+        auto req = this->parent().template recycled_resource<details::write_req<Deleter>>(std::move(data), len, sent);
+        return submit<void>(std::move(req), as_uv_stream());
     }
 
     /**
@@ -292,15 +867,48 @@ public:
      * @return Underlying return value.
      */
     int write(char *data, unsigned int len) {
-        auto req = this->parent().template resource<details::write_req<void (*)(char *)>>(std::unique_ptr<char[], void (*)(char *)>{data, [](char *) {}}, len);
-        auto listener = [ptr = this->shared_from_this()](const auto &event, const auto &) {
-            ptr->publish(event);
-        };
+        const std::array bufs{uv_buf_init(data, len)};
 
-        req->template on<error_event>(listener);
-        req->template on<write_event>(listener);
+        if(gather(bufs)) {
+            return 0;
+        }
+
+        const auto sent = static_cast<unsigned int>(attempt(bufs));
+
+        if(sent && sent == len) {
+            return complete(1u);
+        }
+
+        auto req = this->parent().template recycled_resource<details::write_req<void (*)(char *)>>(std::unique_ptr<char[], void (*)(char *)>{data, [](char *) {}}, len, sent);
+        return submit<void>(std::move(req), as_uv_stream());
+    }
+
+    /**
+     * @brief Writes data to the stream.
+     * @sa write
+     * @tparam Handler Type to which write and error events are dispatched.
+     * @param data The data to be written to the stream.
+     * @param len The lenght of the submitted data.
+     * @return Underlying return value.
+     */
+    template<typename Handler, typename Deleter>
+    int write(static_handler<Handler>, std::unique_ptr<char[], Deleter> data, unsigned int len) {
+        auto req = this->parent().template recycled_resource<details::write_req<Deleter>>(std::move(data), len);
+        return submit<Handler>(std::move(req), as_uv_stream());
+    }
 
-        return req->write(as_uv_stream());
+    /**
+     * @brief Writes data to the stream.
+     * @sa write
+     * @tparam Handler Type to which write and error events are dispatched.
+     * @param data The data to be written to the stream.
+     * @param len The lenght of the submitted data.
+     * @return Underlying return value.
+     */
+    template<typename Handler>
+    int write(static_handler<Handler>, char *data, unsigned int len) {
+        auto req = this->parent().template recycled_resource<details::write_req<void (*)(char *)>>(std::unique_ptr<char[], void (*)(char *)>{data, [](char *) {}}, len);
+        return submit<Handler>(std::move(req), as_uv_stream());
     }
 
     /**
@@ -324,15 +932,8 @@ public:
      */
     template<typename S, typename Deleter>
     int write(S &send, std::unique_ptr<char[], Deleter> data, unsigned int len) {
-        auto req = this->parent().template resource<details::write_req<Deleter>>(std::move(data), len);
-        auto listener = [ptr = this->shared_from_this()](const auto &event, const auto &) {
-            ptr->publish(event);
-        };
-
-        req->template on<error_event>(listener);
-        req->template on<write_event>(listener);
-
-        return req->write(as_uv_stream(), send.as_uv_stream());
+        auto req = this->parent().template recycled_resource<details::write_req<Deleter>>(std::move(data), len);
+        return submit<void>(std::move(req), as_uv_stream(), send.as_uv_stream());
     }
 
     /**
@@ -356,15 +957,111 @@ public:
      */
     template<typename S>
     int write(S &send, char *data, unsigned int len) {
-        auto req = this->parent().template resource<details::write_req<void (*)(char *)>>(std::unique_ptr<char[], void (*)(char *)>{data, [](char *) {}}, len);
-        auto listener = [ptr = this->shared_from_this()](const auto &event, const auto &) {
-            ptr->publish(event);
-        };
+        auto req = this->parent().template recycled_resource<details::write_req<void (*)(char *)>>(std::unique_ptr<char[], void (*)(char *)>{data, [](char *) {}}, len);
+        return submit<void>(std::move(req), as_uv_stream(), send.as_uv_stream());
+    }
 
-        req->template on<error_event>(listener);
-        req->template on<write_event>(listener);
+    /**
+     * @brief Writes multiple buffers to the stream at once.
+     *
+     * Buffers are sent in order by means of a single write request. The handle
+     * takes the ownership of the data and it is in charge of delete them.
+     *
+     * A write event will be emitted when all the data have been written.
+     *
+     * @param data The buffers to be written to the stream, each one along with
+     * its length.
+     * @return Underlying return value.
+     */
+    template<typename Deleter>
+    int write(std::vector<std::pair<std::unique_ptr<char[], Deleter>, unsigned int>> data) {
+        if(gather(data)) {
+            return 0;
+        }
+
+        const auto sent = attempt(data);
+
+        if(sent && sent == details::total_of(data)) {
+            return complete(1u);
+        }
 
-        return req->write(as_uv_stream(), send.as_uv_stream());
+        auto req = this->parent().template recycled_resource<details::writev_req<Deleter>>(std::move(data));
+        req->consume(sent);
+        return submit<void>(std::move(req), as_uv_stream());
+    }
+
+    /**
+     * @brief Writes multiple buffers to the stream at once.
+     *
+     * Buffers are sent in order by means of a single write request. Any
+     * contiguous sequence of `uv_buf_t` is accepted (as an example, a
+     * `std::array` or a `std::vector`). The sequence itself can be discarded
+     * once the function returns, while the handle doesn't take the ownership of
+     * the data. Be sure that their lifetime overcome the one of the request.
+     *
+     * A write event will be emitted when all the data have been written.
+     *
+     * @param bufs The buffers to be written to the stream.
+     * @return Underlying return value.
+     */
+    template<typename Bufs>
+    std::enable_if_t<details::is_buffer_sequence_v<Bufs>, int> write(const Bufs &bufs) {
+        if(gather(bufs)) {
+            return 0;
+        }
+
+        const auto sent = attempt(bufs);
+
+        if(sent && sent == details::total_of(bufs)) {
+            return complete(1u);
+        }
+
+        auto req = this->parent().template recycled_resource<details::writev_req<void (*)(char *)>>();
+
+        if(sent) {
+            // the request keeps the views, trimmed past the data already sent
+            req->assign(std::data(bufs), static_cast<unsigned int>(std::size(bufs)));
+            req->consume(sent);
+            return submit<void>(std::move(req), as_uv_stream());
+        }
+
+        return submit<void>(std::move(req), as_uv_stream(), std::data(bufs), static_cast<unsigned int>(std::size(bufs)));
+    }
+
+    /**
+     * @brief Extended write function for sending handles and multiple buffers
+     * over a pipe handle.
+     *
+     * Same as `write(S &, std::unique_ptr<char[], Deleter>, unsigned int)`,
+     * but buffers are sent in order by means of a single write request.
+     *
+     * @param send The handle over which to write data.
+     * @param data The buffers to be written to the stream, each one along with
+     * its length.
+     * @return Underlying return value.
+     */
+    template<typename S, typename Deleter>
+    int write(S &send, std::vector<std::pair<std::unique_ptr<char[], Deleter>, unsigned int>> data) {
+        auto req = this->parent().template recycled_resource<details::writev_req<Deleter>>(std::move(data));
+        return submit<void>(std::move(req), as_uv_stream(), send.as_uv_stream());
+    }
+
+    /**
+     * @brief Extended write function for sending handles and multiple buffers
+     * over a pipe handle.
+     *
+     * Same as `write(S &, char *, unsigned int)`, but buffers are sent in order
+     * by means of a single write request. Any contiguous sequence of `uv_buf_t`
+     * is accepted.
+     *
+     * @param send The handle over which to write data.
+     * @param bufs The buffers to be written to the stream.
+     * @return Underlying return value.
+     */
+    template<typename S, typename Bufs>
+    std::enable_if_t<details::is_buffer_sequence_v<Bufs>, int> write(S &send, const Bufs &bufs) {
+        auto req = this->parent().template recycled_resource<details::writev_req<void (*)(char *)>>();
+        return submit<void>(std::move(req), as_uv_stream(), std::data(bufs), static_cast<unsigned int>(std::size(bufs)), send.as_uv_stream());
     }
 
     /**
@@ -378,6 +1075,7 @@ public:
      * @return Underlying return value.
      */
     int try_write(std::unique_ptr<char[]> data, unsigned int len) {
+        flush();
         std::array bufs{uv_buf_init(data.get(), len)};
         return uv_try_write(as_uv_stream(), bufs.data(), 1);
     }
@@ -394,6 +1092,7 @@ public:
      */
     template<typename V, typename W>
     int try_write(std::unique_ptr<char[]> data, unsigned int len, stream_handle<V, W> &send) {
+        flush();
         std::array bufs{uv_buf_init(data.get(), len)};
         return uv_try_write2(as_uv_stream(), bufs.data(), 1, send.raw());
     }
@@ -409,6 +1108,7 @@ public:
      * @return Underlying return value.
      */
     int try_write(char *data, unsigned int len) {
+        flush();
         std::array bufs{uv_buf_init(data, len)};
         return uv_try_write(as_uv_stream(), bufs.data(), 1);
     }
@@ -425,10 +1125,118 @@ public:
      */
     template<typename V, typename W>
     int try_write(char *data, unsigned int len, stream_handle<V, W> &send) {
+        flush();
         std::array bufs{uv_buf_init(data, len)};
         return uv_try_write2(as_uv_stream(), bufs.data(), 1, send.raw());
     }
 
+    /**
+     * @brief Queues a write request for multiple buffers if it can be completed
+     * immediately.
+     *
+     * Same as `write()`, but won’t queue a write request if it can’t be
+     * completed immediately. Any contiguous sequence of `uv_buf_t` is accepted.
+     *
+     * @param bufs The buffers to be written to the stream.
+     * @return Underlying return value.
+     */
+    template<typename Bufs>
+    std::enable_if_t<details::is_buffer_sequence_v<Bufs>, int> try_write(const Bufs &bufs) {
+        flush();
+        return std::size(bufs) ? uv_try_write(as_uv_stream(), std::data(bufs), static_cast<unsigned int>(std::size(bufs))) : UV_EINVAL;
+    }
+
+    /**
+     * @brief Queues a write request for multiple buffers if it can be completed
+     * immediately.
+     *
+     * Same as `try_write` for sending handles over a pipe.
+     *
+     * @param bufs The buffers to be written to the stream.
+     * @param send A valid handle suitable for the purpose.
+     * @return Underlying return value.
+     */
+    template<typename Bufs, typename V, typename W>
+    std::enable_if_t<details::is_buffer_sequence_v<Bufs>, int> try_write(const Bufs &bufs, stream_handle<V, W> &send) {
+        flush();
+        return std::size(bufs) ? uv_try_write2(as_uv_stream(), std::data(bufs), static_cast<unsigned int>(std::size(bufs)), send.as_uv_stream()) : UV_EINVAL;
+    }
+
+    /**
+     * @brief Sends the content of a file to the stream.
+     *
+     * Data are sent in chunks by means of `sendfile` on the threadpool, so that
+     * they never go through user space. Whenever the socket buffer is full (as
+     * well as when other writes are pending on the stream), a chunk is read
+     * and written in place of it instead, that is, the transfer waits for the
+     * stream to be writable and data sent are kept in order.<br/>
+     * Streams other than tcp handles don't support `sendfile`, data are read
+     * and written in chunks in this case.
+     *
+     * A send file progress event is emitted for each chunk sent, a send file
+     * event is emitted when the transfer is complete. The handle is kept alive
+     * until then.<br/>
+     * Closing the stream cancels the transfer, an error event is emitted in
+     * this case. The socket stays open until the chunk in progress (if any)
+     * returns from the threadpool.
+     *
+     * Chunks never exceed the room left in the socket buffer, where the
+     * platform reports it. This way, a peer that doesn't read doesn't keep a
+     * thread of the threadpool busy.
+     *
+     * @note
+     * Don't write to the stream while a transfer is in progress. The handle
+     * doesn't take the ownership of the file, be sure that it stays open until
+     * the transfer is complete.
+     *
+     * @param file A valid file handle, open for reading.
+     * @param offset The offset from which to start reading.
+     * @param length The amount of data to send.
+     * @return Underlying return value.
+     */
+    int send_file(file_handle file, int64_t offset, std::size_t length) {
+        flush();
+
+        auto req = this->parent().template recycled_resource<details::send_file_req>(as_uv_stream(), static_cast<uv_file>(file), offset, length);
+        auto listener = [ptr = this->shared_from_this()](const auto &event, const auto &) {
+            ptr->publish(event);
+        };
+
+        req->template on<error_event>(listener);
+        req->template on<send_file_progress_event>(listener);
+        req->template on<send_file_event>(listener);
+
+        const auto err = req->send();
+        return track(req, err);
+    }
+
+    /**
+     * @brief Sends the content of a file to the stream.
+     *
+     * Same as `send_file(file_handle, int64_t, std::size_t)`, but the file is
+     * opened before the transfer and closed once it's complete.
+     *
+     * @param path The path of the file to send.
+     * @param offset The offset from which to start reading.
+     * @param length The amount of data to send.
+     * @return Underlying return value.
+     */
+    int send_file(const std::string &path, int64_t offset, std::size_t length) {
+        flush();
+
+        auto req = this->parent().template recycled_resource<details::send_file_req>(as_uv_stream(), -1, offset, length);
+        auto listener = [ptr = this->shared_from_this()](const auto &event, const auto &) {
+            ptr->publish(event);
+        };
+
+        req->template on<error_event>(listener);
+        req->template on<send_file_progress_event>(listener);
+        req->template on<send_file_event>(listener);
+
+        const auto err = req->send(path);
+        return track(req, err);
+    }
+
     /**
      * @brief Checks if the stream is readable.
      * @return True if the stream is readable, false otherwise.
@@ -471,6 +1279,260 @@ public:
     [[nodiscard]] size_t write_queue_size() const noexcept {
         return uv_stream_get_write_queue_size(as_uv_stream());
     }
+
+    /**
+     * @brief Sets the timer wheel that tracks the deadlines of the stream.
+     *
+     * Many streams can share the same timer wheel, which is the whole point of
+     * it: no timer handles are created on a per-stream basis. Pending
+     * deadlines are cancelled and the durations set so far are discarded.
+     *
+     * @param wheel A timer wheel, an invalid pointer to disable deadlines.
+     */
+    void timeouts(std::shared_ptr<timer_wheel> wheel) {
+        deadlines.reset();
+
+        if(wheel) {
+            deadlines = std::make_unique<details::stream_timeouts>();
+            deadlines->wheel = std::move(wheel);
+        }
+    }
+
+    /**
+     * @brief Sets a deadline on the stream.
+     *
+     * Available deadlines are:
+     *
+     * * `stream_handle::timeout_type::READ`: Armed when the deadline is set
+     * and whenever reading starts, it's restarted on every read and cancelled
+     * when reading stops or the stream ends.
+     * * `stream_handle::timeout_type::WRITE`: Armed as long as write requests
+     * are stalled because the socket buffer is full, it's restarted whenever
+     * a write request completes.
+     * * `stream_handle::timeout_type::LIFETIME`: Armed when the deadline is
+     * set, never restarted.
+     *
+     * A timeout event is emitted when a deadline expires. Streams aren't closed
+     * on timeouts, it's up to the listener to decide what to do.<br/>
+     * Writes made by means of `send_file()` don't affect deadlines.
+     *
+     * @param type The deadline to set.
+     * @param duration The duration of the deadline, zero to disable it.
+     * @return True in case of success, false if there is no timer wheel.
+     */
+    bool timeout(timeout_type type, timer_wheel::time duration) {
+        if(!deadlines) {
+            return false;
+        }
+
+        deadlines->duration[static_cast<std::size_t>(type)] = duration;
+
+        if(type == timeout_type::WRITE && write_queue_size() == 0u) {
+            cancel(type);
+        } else {
+            restart(type);
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Sets the watermarks of the write queue.
+     *
+     * A pressure event is emitted when a write brings the write queue to the
+     * high watermark or beyond it. A drain event is emitted when the write
+     * queue falls to the low watermark afterwards. Use them to stop producing
+     * data while a slow peer catches up, so as to keep memory bounded.
+     *
+     * @param high The high watermark, zero to disable watermarks.
+     * @param low The low watermark.
+     */
+    void watermarks(std::size_t high, std::size_t low = 0u) {
+        backpressure.reset();
+
+        if(high) {
+            backpressure = std::make_unique<details::stream_backpressure>();
+            backpressure->high = high;
+            backpressure->low = (std::min)(low, high);
+        }
+    }
+
+    /**
+     * @brief Sets the watermarks of the write queue and pairs the stream with
+     * an upstream.
+     *
+     * Same as `watermarks(std::size_t, std::size_t)`. Moreover, the upstream
+     * stops reading when the stream is under pressure and starts reading
+     * again (with the same callbacks) when the write queue drains. This is the
+     * way to proxy data from a fast peer to a slow one.<br/>
+     * The upstream isn't kept alive by the stream.
+     *
+     * @note
+     * Don't start nor stop reading on the upstream while the stream is under
+     * pressure.
+     *
+     * @param high The high watermark, zero to disable watermarks.
+     * @param low The low watermark.
+     * @param source The stream from which data are read.
+     */
+    template<typename S>
+    void watermarks(std::size_t high, std::size_t low, std::shared_ptr<S> source) {
+        watermarks(high, low);
+
+        if(backpressure && source) {
+            backpressure->source = std::move(source);
+            backpressure->throttle = &throttle<S>;
+        }
+    }
+
+    /**
+     * @brief Enables cork mode.
+     *
+     * Small writes made while the stream is corked are gathered and sent all
+     * at once by means of a single write request. Data are copied into a buffer
+     * taken from the pool of the loop, therefore the handle never retains the
+     * data submitted by the caller.<br/>
+     * Gathered data are sent at the end of the loop iteration (that is, after
+     * polling for I/O), when the threshold is reached or when `flush()` is
+     * invoked. Writes as large as the threshold aren't copied, they are sent
+     * right after the data gathered so far. Data are always sent in order.
+     *
+     * A write event (or an error event) is still emitted for each write, once
+     * the data to which it belongs have been written.<br/>
+     * Only plain writes are gathered. Writes with static handlers, writes that
+     * send handles over a pipe and any other operation on the write side of
+     * the stream flush the data gathered so far.
+     *
+     * @note
+     * Data gathered are flushed when the stream is closed. They are discarded
+     * if cork mode is disabled without flushing them or if the stream is
+     * destroyed in the meantime.
+     *
+     * @param threshold The amount of data that triggers a flush.
+     * @return True in case of success, false otherwise.
+     */
+    bool cork(std::size_t threshold = DEFAULT_CORK_THRESHOLD) {
+        if(!acquire_writer()) {
+            return false;
+        }
+
+        // gathered data fit the old threshold only
+        flush();
+        writer->data.reset();
+        writer->threshold = (std::max)(threshold, std::size_t{1u});
+
+        return true;
+    }
+
+    /**
+     * @brief Disables cork mode.
+     *
+     * Data gathered so far are flushed.
+     *
+     * @return Underlying return value.
+     */
+    int uncork() {
+        const auto err = flush();
+
+        if(writer) {
+            writer->threshold = 0u;
+            writer->data.reset();
+        }
+
+        return err;
+    }
+
+    /**
+     * @brief Checks if cork mode is enabled.
+     * @return True if cork mode is enabled, false otherwise.
+     */
+    [[nodiscard]] bool corked() const noexcept {
+        return writer && writer->threshold;
+    }
+
+    /**
+     * @brief Sends the data gathered in cork mode, if any.
+     *
+     * Error events are emitted for the gathered writes in case of errors.
+     *
+     * @return Underlying return value.
+     */
+    int flush() {
+        if(!writer || !writer->length) {
+            return 0;
+        }
+
+        const auto count = std::exchange(writer->writes, 0u);
+        const auto len = static_cast<unsigned int>(std::exchange(writer->length, 0u));
+        const auto sent = static_cast<unsigned int>(attempt(std::array{uv_buf_init(writer->data.get(), len)}));
+
+        if(sent == len) {
+            // the buffer is reused for the next round
+            return complete(count);
+        }
+
+        auto req = this->parent().template recycled_resource<details::write_req<buffer_deleter>>(std::move(writer->data), len, sent);
+
+        if(const auto err = submit<void>(count, std::move(req), as_uv_stream()); err) {
+            for(auto next = count; next; --next) {
+                this->publish(error_event{err});
+            }
+
+            return err;
+        }
+
+        return 0;
+    }
+
+    /**
+     * @brief Enables or disables eager writes.
+     *
+     * When eager writes are enabled, plain writes try to send data right away
+     * by means of `uv_try_write`, as long as no other write is pending on the
+     * stream. A write request is created only for the data that the kernel
+     * doesn't accept immediately, if any. Data are always sent in order.<br/>
+     * This saves a request and a trip through the loop for the common case of
+     * a socket that isn't under pressure. It works along with cork mode, in
+     * which case the gathered data are sent eagerly on flush.
+     *
+     * A write event is still emitted for each write. Events for writes that
+     * completed immediately are emitted at the end of the loop iteration (or
+     * before the write event of the next write request), never from within
+     * the call to `write`.<br/>
+     * Errors, including `UV_EAGAIN`, are reported as usual by the write
+     * request that follows.
+     *
+     * @note
+     * The handle doesn't retain the data submitted by the caller when they are
+     * sent immediately. Borrowed data must still outlive the write event.
+     *
+     * @param enable True to enable eager writes, false otherwise.
+     * @return True in case of success, false otherwise.
+     */
+    bool eager_writes(bool enable) {
+        if(!acquire_writer()) {
+            return false;
+        }
+
+        writer->eager = enable;
+
+        return true;
+    }
+
+    /**
+     * @brief Checks if eager writes are enabled.
+     * @return True if eager writes are enabled, false otherwise.
+     */
+    [[nodiscard]] bool eager_writes() const noexcept {
+        return writer && writer->eager;
+    }
+
+private:
+    std::unique_ptr<details::stream_timeouts> deadlines{};
+    std::unique_ptr<details::stream_backpressure> backpressure{};
+    std::unique_ptr<details::stream_writer> writer{};
+    std::vector<std::weak_ptr<details::send_file_req>> transfers{};
+    std::size_t requests{};
 };
 
 } // namespace uvw
@@ -1,11 +1,42 @@
+#include <algorithm>
+#include <utility>
 #include "config.h"
 
+#ifndef _WIN32
+#    include <sys/socket.h>
+#    include <unistd.h>
+#endif
+
+#ifdef __linux__
+#    include <linux/sockios.h>
+#    include <sys/ioctl.h>
+#endif
+
 namespace uvw {
 
-UVW_INLINE data_event::data_event(std::unique_ptr<char[]> buf, std::size_t len) noexcept
+UVW_INLINE data_event::data_event(std::unique_ptr<char[], buffer_deleter> buf, std::size_t len) noexcept
     : data{std::move(buf)},
       length{len} {}
 
+UVW_INLINE details::stream_timeouts::~stream_timeouts() noexcept {
+    for(auto &&tkn: token) {
+        wheel->stop(tkn);
+    }
+}
+
+UVW_INLINE details::stream_backpressure::~stream_backpressure() noexcept {
+    if(pressure && throttle) {
+        // never leave the upstream paused
+        throttle(*this, false);
+    }
+}
+
+UVW_INLINE details::stream_writer::~stream_writer() noexcept {
+    if(hook) {
+        hook->close();
+    }
+}
+
 UVW_INLINE void details::connect_req::connect_callback(uv_connect_t *req, int status) {
     if(auto ptr = reserve(req); status) {
         ptr->publish(error_event{status});
@@ -26,4 +57,230 @@ UVW_INLINE int details::shutdown_req::shutdown(uv_stream_t *hndl) {
     return this->leak_if(uv_shutdown(raw(), hndl, &shoutdown_callback));
 }
 
+UVW_INLINE void details::send_file_req::fs_send_callback(uv_fs_t *req) {
+    auto ptr = reserve(req);
+    const auto result = static_cast<int>(req->result);
+
+    switch(req->fs_type) {
+    case UV_FS_OPEN:
+        if(result < 0) {
+            ptr->finish(result);
+        } else {
+            ptr->in = result;
+            ptr->advance();
+        }
+        break;
+    case UV_FS_SENDFILE:
+        ptr->sending = false;
+
+        if(ptr->cancelled) {
+            // errors are likely due to the socket being shut down
+            ptr->finish(UV_ECANCELED);
+        } else if(result == UV_EAGAIN) {
+            // the socket buffer is full, a write request waits for the stream to be writable
+            ptr->stalled = true;
+            ptr->advance();
+        } else if(result < 0) {
+            ptr->finish(result);
+        } else {
+            ptr->progress(static_cast<std::size_t>(req->result));
+        }
+        break;
+    case UV_FS_READ:
+        if(ptr->cancelled) {
+            ptr->data.reset();
+            ptr->finish(UV_ECANCELED);
+        } else if(result < 0) {
+            ptr->data.reset();
+            ptr->finish(result);
+        } else if(result == 0) {
+            ptr->data.reset();
+            ptr->progress(0u);
+        } else {
+            const auto buf = uv_buf_init(ptr->data.get(), static_cast<unsigned int>(result));
+
+            if(auto err = uv_write(&ptr->writer, ptr->target, &buf, 1, &write_callback); err != 0) {
+                ptr->finish(err);
+            } else {
+                static_cast<void>(ptr->leak_if(0));
+            }
+        }
+        break;
+    case UV_FS_CLOSE:
+        ptr->in = -1;
+        ptr->finish(ptr->status);
+        break;
+    default:
+        // nothing to do here
+        break;
+    }
+}
+
+UVW_INLINE void details::send_file_req::write_callback(uv_write_t *req, int status) {
+    auto &ref = *static_cast<send_file_req *>(req->data);
+    auto ptr = ref.shared_from_this();
+    ref.self_reset();
+    ref.data.reset();
+
+    if(ref.cancelled) {
+        ref.finish(UV_ECANCELED);
+    } else if(status) {
+        ref.finish(status);
+    } else {
+        ref.progress(static_cast<std::size_t>(ref.raw()->result));
+    }
+}
+
+UVW_INLINE std::size_t details::send_file_req::window() const noexcept {
+    auto len = std::min(remaining, SEND_CHUNK);
+
+#ifdef __linux__
+    int size{};
+    int queued{};
+
+    // the kernel doubles the size of the buffer to account for its own overhead
+    if(uv_send_buffer_size(reinterpret_cast<uv_handle_t *>(target), &size) == 0 && ioctl(out, SIOCOUTQ, &queued) == 0) {
+        const auto room = size / 2 - queued;
+        len = (room > 0) ? std::min(len, static_cast<std::size_t>(room)) : 0u;
+    }
+#endif
+
+    return len;
+}
+
+UVW_INLINE int details::send_file_req::step() {
+    uv_fs_req_cleanup(raw());
+
+    if(zero_copy && !stalled && !uv_stream_get_write_queue_size(target)) {
+        // workers never wait for the peer, full buffers are waited for on the loop
+        if(const auto len = window(); len) {
+            sending = true;
+            return uv_fs_sendfile(parent().raw(), raw(), out, in, position, len, &fs_send_callback);
+        }
+    }
+
+    stalled = false;
+    data = parent().buffers().acquire(COPY_CHUNK);
+    const auto buf = uv_buf_init(data.get(), static_cast<unsigned int>(std::min(remaining, COPY_CHUNK)));
+    return uv_fs_read(parent().raw(), raw(), in, &buf, 1, position, &fs_send_callback);
+}
+
+UVW_INLINE void details::send_file_req::progress(std::size_t len) {
+    if(len == 0u) {
+        // end of file
+        remaining = 0u;
+    } else {
+        sent += len;
+        remaining -= len;
+        position += static_cast<int64_t>(len);
+        publish(send_file_progress_event{sent, total});
+    }
+
+    advance();
+}
+
+UVW_INLINE void details::send_file_req::advance() {
+    if(remaining == 0u) {
+        finish(0);
+    } else if(cancelled || uv_is_closing(reinterpret_cast<uv_handle_t *>(target))) {
+        finish(UV_ECANCELED);
+    } else if(auto err = step(); err != 0) {
+        finish(err);
+    } else {
+        static_cast<void>(leak_if(0));
+    }
+}
+
+UVW_INLINE void details::send_file_req::finish(int err) {
+    status = err;
+
+    if(owned && in >= 0) {
+        uv_fs_req_cleanup(raw());
+
+        // the file is closed first if it was opened by the request
+        if(uv_fs_close(parent().raw(), raw(), in, &fs_send_callback) == 0) {
+            static_cast<void>(leak_if(0));
+            return;
+        }
+    }
+
+    if(status) {
+        publish(error_event{status});
+    } else {
+        publish(send_file_event{sent});
+    }
+}
+
+UVW_INLINE details::send_file_req::send_file_req(loop::token token, std::shared_ptr<loop> parent, uv_stream_t *hndl, uv_file file, int64_t offset, std::size_t length)
+    : request{token, std::move(parent)},
+      data{},
+      writer{},
+      target{hndl},
+      out{-1},
+      in{file},
+      position{offset},
+      remaining{length},
+      total{length},
+      sent{},
+      status{},
+      zero_copy{},
+      owned{},
+      stalled{},
+      sending{},
+      cancelled{} {
+    writer.data = this;
+#ifndef _WIN32
+    // sendfile is emulated on Windows and requires a socket as a target elsewhere
+    if(uv_os_fd_t fd{}; (hndl->type == UV_TCP) && (uv_fileno(reinterpret_cast<uv_handle_t *>(hndl), &fd) == 0)) {
+        // workers write to a duplicate, the descriptor can't be reused while they are at it
+        out = ::dup(fd);
+        zero_copy = (out >= 0);
+    }
+#endif
+}
+
+UVW_INLINE details::send_file_req::~send_file_req() noexcept {
+    uv_fs_req_cleanup(raw());
+
+#ifndef _WIN32
+    if(out >= 0) {
+        ::close(out);
+    }
+#endif
+}
+
+UVW_INLINE int details::send_file_req::send() {
+    if(remaining == 0u) {
+        return UV_EINVAL;
+    }
+
+    return leak_if(step());
+}
+
+UVW_INLINE int details::send_file_req::send(const std::string &path) {
+    if(remaining == 0u) {
+        return UV_EINVAL;
+    }
+
+    owned = true;
+    uv_fs_req_cleanup(raw());
+    return leak_if(uv_fs_open(parent().raw(), raw(), path.data(), UV_FS_O_RDONLY, 0, &fs_send_callback));
+}
+
+UVW_INLINE void details::send_file_req::cancel() noexcept {
+    cancelled = true;
+
+    if(raw()->fs_type != UV_FS_CLOSE) {
+        // operations not yet picked up by a worker are dropped, files are always closed
+        uv_cancel(reinterpret_cast<uv_req_t *>(raw()));
+    }
+
+#ifndef _WIN32
+    if(sending) {
+        // wakes up a worker waiting for the socket to be writable, if any
+        ::shutdown(out, SHUT_WR);
+    }
+#endif
+}
+
 } // namespace uvw
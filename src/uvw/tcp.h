@@ -19,6 +19,7 @@ namespace details {
 
 enum class uvw_tcp_flags : std::underlying_type_t<uv_tcp_flags> {
     IPV6ONLY = UV_TCP_IPV6ONLY,
+    REUSEPORT = UV_TCP_REUSEPORT,
     UVW_ENUM = 0
 };
 
@@ -110,6 +111,9 @@ public:
      *
      * * `tcp_handle::tcp_flags::IPV6ONLY`: it disables dual-stack support and
      * only IPv6 is used.
+     * * `tcp_handle::tcp_flags::REUSEPORT`: it enables `SO_REUSEPORT` so that
+     * multiple handles (usually on different threads) can bind the same
+     * address and port and the kernel balances connections among them.
      *
      * @param addr Initialized `sockaddr_in` or `sockaddr_in6` data structure.
      * @param opts Optional additional flags.
@@ -127,6 +131,9 @@ public:
      *
      * * `tcp_handle::tcp_flags::IPV6ONLY`: it disables dual-stack support and
      * only IPv6 is used.
+     * * `tcp_handle::tcp_flags::REUSEPORT`: it enables `SO_REUSEPORT` so that
+     * multiple handles (usually on different threads) can bind the same
+     * address and port and the kernel balances connections among them.
      *
      * @param ip The address to which to bind.
      * @param port The port to which to bind.
@@ -145,6 +152,9 @@ public:
      *
      * * `tcp_handle::tcp_flags::IPV6ONLY`: it disables dual-stack support and
      * only IPv6 is used.
+     * * `tcp_handle::tcp_flags::REUSEPORT`: it enables `SO_REUSEPORT` so that
+     * multiple handles (usually on different threads) can bind the same
+     * address and port and the kernel balances connections among them.
      *
      * @param addr A valid instance of socket_address.
      * @param opts Optional additional flags.
@@ -207,7 +217,8 @@ public:
      * This is accomplished by setting the `SO_LINGER` socket option with a
      * linger interval of zero and then calling `close`.<br/>
      * Due to some platform inconsistencies, mixing of `shutdown` and
-     * `close_reset` calls is not allowed.
+     * `close_reset` calls is not allowed.<br/>
+     * Data gathered in cork mode are flushed first, as with `close`.
      *
      * A close event is emitted when the connection has been reset.
      *
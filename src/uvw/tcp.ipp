@@ -64,11 +64,11 @@ UVW_INLINE int tcp_handle::connect(const socket_address &addr) {
 }
 
 UVW_INLINE int tcp_handle::connect(const sockaddr &addr) {
-    auto listener = [ptr = shared_from_this()](const auto &event, const auto &) {
+    auto listener = [ptr = this](const auto &event, const auto &) {
         ptr->publish(event);
     };
 
-    auto req = parent().resource<details::connect_req>();
+    auto req = parent().recycled_resource<details::connect_req>();
     req->on<error_event>(listener);
     req->on<connect_event>(listener);
 
@@ -76,7 +76,18 @@ UVW_INLINE int tcp_handle::connect(const sockaddr &addr) {
 }
 
 UVW_INLINE int tcp_handle::close_reset() {
-    return uv_tcp_close_reset(raw(), &this->close_callback);
+    if(!closing()) {
+        // gathered data are treated like any other write already submitted
+        flush();
+    }
+
+    const auto err = uv_tcp_close_reset(raw(), &this->close_callback);
+
+    if(err == 0) {
+        detach();
+    }
+
+    return err;
 }
 
 } // namespace uvw
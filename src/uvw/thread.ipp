@@ -50,12 +50,15 @@ UVW_INLINE thread::~thread() noexcept {
 }
 
 UVW_INLINE bool thread::run() noexcept {
-    return (0 == uv_thread_create(raw(), &create_callback, this));
+    // a thread that failed to start mustn't be joined later on
+    joinable = (0 == uv_thread_create(raw(), &create_callback, this));
+    return joinable;
 }
 
 UVW_INLINE bool thread::run(create_flags opts, std::size_t stack) noexcept {
     uv_thread_options_t params{static_cast<unsigned int>(opts), stack};
-    return (0 == uv_thread_create_ex(raw(), &params, &create_callback, this));
+    joinable = (0 == uv_thread_create_ex(raw(), &params, &create_callback, this));
+    return joinable;
 }
 
 UVW_INLINE bool thread::join() noexcept {
@@ -0,0 +1,2 @@
+#include "timer_wheel.h"
+#include "timer_wheel.ipp"
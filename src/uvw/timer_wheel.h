@@ -0,0 +1,239 @@
+#ifndef UVW_TIMER_WHEEL_INCLUDE_H
+#define UVW_TIMER_WHEEL_INCLUDE_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <uv.h>
+#include "config.h"
+#include "emitter.h"
+#include "handle.hpp"
+#include "loop.h"
+#include "timer.h"
+
+namespace uvw {
+
+/**
+ * @brief Token of a timeout managed by a timer wheel.
+ *
+ * Tokens are plain values. A token is invalidated as soon as its timeout
+ * expires or is stopped, even if the slot is reused afterwards.
+ */
+struct timer_token {
+    std::uint32_t index{};      /*!< The slot of the timeout. */
+    std::uint32_t generation{}; /*!< The generation of the slot, 0 for invalid tokens. */
+
+    /**
+     * @brief Checks if a token was ever returned by a timer wheel.
+     * @return True if the token isn't default constructed, false otherwise.
+     */
+    [[nodiscard]] explicit operator bool() const noexcept {
+        return (generation != 0u);
+    }
+
+    [[nodiscard]] bool operator==(const timer_token &other) const noexcept {
+        return (index == other.index) && (generation == other.generation);
+    }
+
+    [[nodiscard]] bool operator!=(const timer_token &other) const noexcept {
+        return !(*this == other);
+    }
+};
+
+/*! @brief Timer wheel event, timeouts expired all at once. */
+struct timer_wheel_event {
+    /*! @brief Expired timeout. */
+    struct entry {
+        timer_token token; /*!< The token of the timeout, no longer valid. */
+        void *data;        /*!< The user data of the timeout. */
+    };
+
+    std::vector<entry> expired; /*!< The timeouts expired, roughly in order. */
+};
+
+/**
+ * @brief The timer wheel.
+ *
+ * A hierarchical timer wheel that manages large numbers of timeouts with a
+ * single timer handle.<br/>
+ * Starting, stopping and restarting a timeout are constant time operations
+ * that don't involve the loop at all. Timeouts are rounded up to the
+ * granularity of the wheel, so that a timeout never expires early and
+ * expires late by less than a tick or so. Timeouts that expire during the same tick
+ * (or the same callback, if the loop lags behind) are emitted with a single
+ * event.
+ *
+ * Each timeout takes a few dozen bytes. Timeouts longer than 2^32 ticks are
+ * supported, although they are less efficient.
+ *
+ * The underlying timer runs only while there are timeouts pending and wakes up
+ * only when a timeout expires or a slot of an outer wheel is due, rather than
+ * on every tick. Like handles, a wheel keeps itself alive until it's closed.
+ *
+ * To create a `timer_wheel` through a `loop`, arguments follow:
+ *
+ * * An optional granularity, that is the duration of a tick. The default
+ * value is 10 milliseconds.
+ *
+ * @note
+ * The underlying timer handle is visible when walking the loop. Closing it
+ * closes the wheel as well.
+ */
+class timer_wheel final: public emitter<timer_wheel, close_event, timer_wheel_event>, public std::enable_shared_from_this<timer_wheel> {
+public:
+    using time = std::chrono::duration<uint64_t, std::milli>;
+    using callback_type = void (*)(void *, timer_token);
+
+private:
+    static constexpr std::uint32_t SLOT_BITS = 8u;
+    static constexpr std::uint32_t SLOTS = 1u << SLOT_BITS;
+    static constexpr std::uint32_t LEVELS = 4u;
+    static constexpr std::uint32_t OVERFLOW_LIST = LEVELS * SLOTS;
+    static constexpr std::uint32_t NONE = ~std::uint32_t{};
+
+    struct node {
+        std::uint64_t expiry;
+        std::uint32_t prev;
+        std::uint32_t next;
+        std::uint32_t generation;
+        std::uint32_t list;
+        callback_type func;
+        void *data;
+    };
+
+    struct notification {
+        callback_type func;
+        timer_wheel_event::entry elem;
+    };
+
+    [[nodiscard]] std::uint64_t elapsed() const noexcept;
+    [[nodiscard]] std::uint64_t deadline(time timeout) const noexcept;
+    [[nodiscard]] bool valid(timer_token tkn) const noexcept;
+
+    void link(std::uint32_t pos) noexcept;
+    void unlink(std::uint32_t pos) noexcept;
+    void release(std::uint32_t pos) noexcept;
+    void cascade(std::uint32_t list);
+    void tick(std::vector<timer_wheel_event::entry> &expired, std::vector<notification> &notified);
+    [[nodiscard]] std::uint64_t next() const noexcept;
+    void schedule();
+    void update();
+
+public:
+    explicit timer_wheel(loop::token token, std::shared_ptr<loop> ref, time tick = time{10});
+
+    timer_wheel(const timer_wheel &) = delete;
+    timer_wheel(timer_wheel &&) = delete;
+
+    timer_wheel &operator=(const timer_wheel &) = delete;
+    timer_wheel &operator=(timer_wheel &&) = delete;
+
+    /**
+     * @brief Initializes the wheel.
+     * @return Underlying return value.
+     */
+    int init();
+
+    /**
+     * @brief Gets the loop from which the wheel was originated.
+     * @return A reference to a loop instance.
+     */
+    [[nodiscard]] loop &parent() const noexcept;
+
+    /**
+     * @brief Gets the granularity of the wheel.
+     * @return The duration of a tick.
+     */
+    [[nodiscard]] time granularity() const noexcept;
+
+    /**
+     * @brief Starts a timeout.
+     *
+     * A timer wheel event is emitted once the timeout expires.
+     *
+     * @param timeout Milliseconds before to time out.
+     * @param data User data attached to the timeout, if any.
+     * @return The token of the timeout.
+     */
+    timer_token start(time timeout, void *data = nullptr);
+
+    /**
+     * @brief Starts a timeout with a callback.
+     *
+     * The callback is invoked with the user data and the token of the timeout
+     * once it expires, after the timer wheel event for the same tick (if any).
+     * Timeouts with a callback aren't part of timer wheel events.
+     *
+     * @param timeout Milliseconds before to time out.
+     * @param func The function to invoke on expiration.
+     * @param data User data attached to the timeout, if any.
+     * @return The token of the timeout.
+     */
+    timer_token start(time timeout, callback_type func, void *data);
+
+    /**
+     * @brief Stops a timeout.
+     * @param tkn The token of the timeout.
+     * @return True in case of success, false if the token is no longer
+     * valid.
+     */
+    bool stop(timer_token tkn) noexcept;
+
+    /**
+     * @brief Restarts a timeout.
+     *
+     * The timeout expires after the given number of milliseconds from now
+     * and the token stays valid.
+     *
+     * @param tkn The token of the timeout.
+     * @param timeout Milliseconds before to time out.
+     * @return True in case of success, false if the token is no longer
+     * valid.
+     */
+    bool again(timer_token tkn, time timeout) noexcept;
+
+    /**
+     * @brief Checks if a timeout is pending.
+     * @param tkn The token of the timeout.
+     * @return True if the timeout is pending, false otherwise.
+     */
+    [[nodiscard]] bool active(timer_token tkn) const noexcept;
+
+    /**
+     * @brief Gets the number of timeouts pending.
+     * @return The number of timeouts pending.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief Requests the wheel to be closed.
+     *
+     * Pending timeouts are discarded.<br/>
+     * A close event is emitted when the wheel has been closed.
+     */
+    void close() noexcept;
+
+private:
+    std::shared_ptr<loop> owner;
+    std::shared_ptr<timer_handle> timer;
+    std::shared_ptr<timer_wheel> self;
+    std::vector<node> nodes;
+    std::array<std::uint32_t, LEVELS * SLOTS + 1u> heads;
+    std::uint64_t origin;
+    std::uint64_t current;
+    std::uint64_t wakeup;
+    std::uint64_t interval;
+    std::uint32_t available;
+    std::size_t count;
+};
+
+} // namespace uvw
+
+#ifndef UVW_AS_LIB
+#    include "timer_wheel.ipp"
+#endif
+
+#endif // UVW_TIMER_WHEEL_INCLUDE_H
@@ -0,0 +1,296 @@
+#include <algorithm>
+#include <utility>
+#include "config.h"
+
+namespace uvw {
+
+UVW_INLINE std::uint64_t timer_wheel::elapsed() const noexcept {
+    return owner->now().count() - origin;
+}
+
+UVW_INLINE std::uint64_t timer_wheel::deadline(time timeout) const noexcept {
+    // rounded up, timeouts never expire early
+    const auto ticks = (elapsed() + timeout.count() + interval - 1u) / interval;
+    return (std::max)(ticks, current + 1u);
+}
+
+UVW_INLINE bool timer_wheel::valid(timer_token tkn) const noexcept {
+    return tkn.index < nodes.size() && nodes[tkn.index].generation == tkn.generation && nodes[tkn.index].list != NONE;
+}
+
+UVW_INLINE void timer_wheel::link(std::uint32_t pos) noexcept {
+    auto &elem = nodes[pos];
+    const auto diff = elem.expiry ^ current;
+    std::uint32_t list = OVERFLOW_LIST;
+
+    if(!(diff >> (SLOT_BITS * LEVELS))) {
+        std::uint32_t level = LEVELS - 1u;
+
+        // the highest group of bits that differs from the current tick
+        while(level && !(diff >> (SLOT_BITS * level))) {
+            --level;
+        }
+
+        list = level * SLOTS + static_cast<std::uint32_t>((elem.expiry >> (SLOT_BITS * level)) & (SLOTS - 1u));
+    }
+
+    elem.prev = NONE;
+    elem.next = heads[list];
+    elem.list = list;
+
+    if(elem.next != NONE) {
+        nodes[elem.next].prev = pos;
+    }
+
+    heads[list] = pos;
+}
+
+UVW_INLINE void timer_wheel::unlink(std::uint32_t pos) noexcept {
+    auto &elem = nodes[pos];
+
+    if(elem.prev == NONE) {
+        heads[elem.list] = elem.next;
+    } else {
+        nodes[elem.prev].next = elem.next;
+    }
+
+    if(elem.next != NONE) {
+        nodes[elem.next].prev = elem.prev;
+    }
+
+    elem.list = NONE;
+}
+
+UVW_INLINE void timer_wheel::release(std::uint32_t pos) noexcept {
+    auto &elem = nodes[pos];
+
+    // outstanding tokens are invalidated, 0 is reserved for invalid ones
+    elem.generation = (elem.generation + 1u) ? (elem.generation + 1u) : 1u;
+    elem.list = NONE;
+    elem.func = nullptr;
+    elem.data = nullptr;
+    elem.next = available;
+    available = pos;
+}
+
+UVW_INLINE void timer_wheel::cascade(std::uint32_t list) {
+    auto pos = std::exchange(heads[list], NONE);
+
+    while(pos != NONE) {
+        const auto next = nodes[pos].next;
+        link(pos);
+        pos = next;
+    }
+}
+
+UVW_INLINE void timer_wheel::tick(std::vector<timer_wheel_event::entry> &expired, std::vector<notification> &notified) {
+    ++current;
+
+    if(!(current & ((std::uint64_t{1u} << (SLOT_BITS * LEVELS)) - 1u))) {
+        cascade(OVERFLOW_LIST);
+    }
+
+    for(auto level = LEVELS - 1u; level; --level) {
+        if(!(current & ((std::uint64_t{1u} << (SLOT_BITS * level)) - 1u))) {
+            cascade(level * SLOTS + static_cast<std::uint32_t>((current >> (SLOT_BITS * level)) & (SLOTS - 1u)));
+        }
+    }
+
+    auto pos = std::exchange(heads[current & (SLOTS - 1u)], NONE);
+
+    while(pos != NONE) {
+        const auto next = nodes[pos].next;
+        const timer_wheel_event::entry elem{timer_token{pos, nodes[pos].generation}, nodes[pos].data};
+
+        if(nodes[pos].func) {
+            notified.push_back(notification{nodes[pos].func, elem});
+        } else {
+            expired.push_back(elem);
+        }
+
+        release(pos);
+        --count;
+        pos = next;
+    }
+}
+
+UVW_INLINE std::uint64_t timer_wheel::next() const noexcept {
+    for(std::uint32_t level{}; level < LEVELS; ++level) {
+        const auto shift = SLOT_BITS * level;
+        const auto base = (current >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+
+        // slots behind the current one are empty, timeouts are linked ahead
+        for(auto slot = static_cast<std::uint32_t>((current >> shift) & (SLOTS - 1u)) + 1u; slot < SLOTS; ++slot) {
+            if(heads[level * SLOTS + slot] != NONE) {
+                // either the timeouts expire or they cascade to an inner wheel
+                return base | (std::uint64_t{slot} << shift);
+            }
+        }
+    }
+
+    return ((current >> (SLOT_BITS * LEVELS)) + 1u) << (SLOT_BITS * LEVELS);
+}
+
+UVW_INLINE void timer_wheel::schedule() {
+    // wake up on the boundary of the first tick that has work to do
+    const auto now = elapsed();
+    wakeup = next();
+    timer->start(time{(std::max)(wakeup * interval, now) - now}, time{0});
+}
+
+UVW_INLINE void timer_wheel::update() {
+    const auto target = elapsed() / interval;
+    std::vector<timer_wheel_event::entry> expired{};
+    std::vector<notification> notified{};
+
+    // catch up in case the loop lagged behind, ticks with nothing to do are skipped
+    while(count && current < target) {
+        if(const auto step = next(); step <= target) {
+            current = step - 1u;
+            tick(expired, notified);
+        } else {
+            break;
+        }
+    }
+
+    current = target;
+
+    if(!expired.empty()) {
+        publish(timer_wheel_event{std::move(expired)});
+    }
+
+    for(auto &&curr: notified) {
+        curr.func(curr.elem.data, curr.elem.token);
+    }
+
+    if(count) {
+        schedule();
+    } else {
+        timer->stop();
+    }
+}
+
+UVW_INLINE timer_wheel::timer_wheel(loop::token, std::shared_ptr<loop> ref, time tick)
+    : owner{std::move(ref)},
+      timer{},
+      self{},
+      nodes{},
+      heads{},
+      origin{},
+      current{},
+      wakeup{},
+      interval{(std::max)(tick.count(), std::uint64_t{1u})},
+      available{NONE},
+      count{} {
+    heads.fill(NONE);
+}
+
+UVW_INLINE int timer_wheel::init() {
+    timer = owner->uninitialized_resource<timer_handle>();
+
+    timer->on<timer_event>([this](const timer_event &, timer_handle &) {
+        update();
+    });
+
+    timer->on<close_event>([this](const close_event &, timer_handle &) {
+        [[maybe_unused]] auto ptr = std::move(self);
+        nodes.clear();
+        heads.fill(NONE);
+        available = NONE;
+        count = 0u;
+        publish(close_event{});
+    });
+
+    const auto err = timer->init();
+
+    if(err == 0) {
+        origin = owner->now().count();
+        self = shared_from_this();
+    }
+
+    return err;
+}
+
+UVW_INLINE loop &timer_wheel::parent() const noexcept {
+    return *owner;
+}
+
+UVW_INLINE timer_wheel::time timer_wheel::granularity() const noexcept {
+    return time{interval};
+}
+
+UVW_INLINE timer_token timer_wheel::start(time timeout, void *data) {
+    return start(timeout, nullptr, data);
+}
+
+UVW_INLINE timer_token timer_wheel::start(time timeout, callback_type func, void *data) {
+    std::uint32_t pos = available;
+
+    if(count == 0u) {
+        // the wheel doesn't turn while empty
+        current = elapsed() / interval;
+    }
+
+    if(pos == NONE) {
+        pos = static_cast<std::uint32_t>(nodes.size());
+        nodes.push_back(node{0u, NONE, NONE, 1u, NONE, nullptr, nullptr});
+    } else {
+        available = nodes[pos].next;
+    }
+
+    nodes[pos].expiry = deadline(timeout);
+    nodes[pos].func = func;
+    nodes[pos].data = data;
+    link(pos);
+
+    if(count++ == 0u || nodes[pos].expiry < wakeup) {
+        schedule();
+    }
+
+    return timer_token{pos, nodes[pos].generation};
+}
+
+UVW_INLINE bool timer_wheel::stop(timer_token tkn) noexcept {
+    if(!valid(tkn)) {
+        return false;
+    }
+
+    unlink(tkn.index);
+    release(tkn.index);
+
+    if(--count == 0u) {
+        timer->stop();
+    }
+
+    return true;
+}
+
+UVW_INLINE bool timer_wheel::again(timer_token tkn, time timeout) noexcept {
+    if(!valid(tkn)) {
+        return false;
+    }
+
+    unlink(tkn.index);
+    nodes[tkn.index].expiry = deadline(timeout);
+    link(tkn.index);
+
+    if(nodes[tkn.index].expiry < wakeup) {
+        schedule();
+    }
+
+    return true;
+}
+
+UVW_INLINE bool timer_wheel::active(timer_token tkn) const noexcept {
+    return valid(tkn);
+}
+
+UVW_INLINE std::size_t timer_wheel::size() const noexcept {
+    return count;
+}
+
+UVW_INLINE void timer_wheel::close() noexcept {
+    timer->close();
+}
+
+} // namespace uvw
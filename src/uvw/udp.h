@@ -2,14 +2,17 @@
 #define UVW_UDP_INCLUDE_H
 
 #include <cstddef>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 #include <uv.h>
 #include "config.h"
 #include "enum.hpp"
 #include "handle.hpp"
+#include "pool.h"
 #include "request.hpp"
 #include "util.h"
 
@@ -18,14 +21,57 @@ namespace uvw {
 /*! @brief Send event. */
 struct send_event {};
 
-/*! @brief UDP data event. */
+/**
+ * @brief UDP data event.
+ *
+ * @note
+ * Unless a custom allocation function is used, data come from the pool of the
+ * loop and must be released on the thread that runs the loop. Copy the data
+ * or move them back to the loop before releasing them elsewhere.
+ */
 struct udp_data_event {
-    explicit udp_data_event(socket_address sndr, std::unique_ptr<char[]> buf, std::size_t len, bool part) noexcept;
+    explicit udp_data_event(raw_socket_address sndr, std::unique_ptr<char[], buffer_deleter> buf, std::size_t len, bool part) noexcept;
+
+    std::unique_ptr<char[], buffer_deleter> data; /*!< A bunch of data read on the stream. */
+    std::size_t length;                           /*!< The amount of data read on the stream. */
+    raw_socket_address sender;                    /*!< A valid instance of raw_socket_address. */
+    bool partial;                                 /*!< True if the message was truncated, false otherwise. */
+};
+
+/*! @brief A datagram within a batch, see `udp_batch_event`. */
+struct udp_datagram {
+    char *data;                /*!< A pointer to the datagram within the buffer of the batch. */
+    std::size_t length;        /*!< The length of the datagram. */
+    raw_socket_address sender; /*!< A valid instance of raw_socket_address. */
+    bool partial;              /*!< True if the message was truncated, false otherwise. */
+};
+
+/**
+ * @brief A message to be sent in a batch.
+ *
+ * See `udp_handle::send_batch` and `udp_handle::try_send_batch`.
+ */
+struct udp_message {
+    raw_socket_address address; /*!< The destination, unspecified for connected handles. */
+    uv_buf_t *bufs;             /*!< The buffers that make up the message. */
+    unsigned int nbufs;         /*!< The number of buffers. */
+};
+
+/**
+ * @brief UDP batch event.
+ *
+ * It carries the datagrams received with a single `recvmmsg` call. Datagrams
+ * are views over a receive buffer owned by the handle, that is reused for the
+ * next batch.
+ *
+ * @note
+ * Datagrams are valid only until the listener returns. Copy the data that
+ * must outlive the event.
+ */
+struct udp_batch_event {
+    explicit udp_batch_event(const std::vector<udp_datagram> &msgs) noexcept;
 
-    std::unique_ptr<char[]> data; /*!< A bunch of data read on the stream. */
-    std::size_t length;           /*!< The amount of data read on the stream. */
-    socket_address sender;        /*!< A valid instance of socket_address. */
-    bool partial;                 /*!< True if the message was truncated, false otherwise. */
+    const std::vector<udp_datagram> &datagrams; /*!< The datagrams received, in order. */
 };
 
 namespace details {
@@ -34,6 +80,7 @@ enum class uvw_udp_flags : std::underlying_type_t<uv_udp_flags> {
     IPV6ONLY = UV_UDP_IPV6ONLY,
     UDP_PARTIAL = UV_UDP_PARTIAL,
     REUSEADDR = UV_UDP_REUSEADDR,
+    REUSEPORT = UV_UDP_REUSEPORT,
     UDP_MMSG_CHUNK = UV_UDP_MMSG_CHUNK,
     UDP_MMSG_FREE = UV_UDP_MMSG_FREE,
     UDP_LINUX_RECVERR = UV_UDP_LINUX_RECVERR,
@@ -52,9 +99,10 @@ class send_req final: public request<send_req, uv_udp_send_t, send_event> {
 public:
     using deleter = void (*)(char *);
 
-    send_req(loop::token token, std::shared_ptr<loop> parent, std::unique_ptr<char[], deleter> dt, unsigned int len);
+    send_req(loop::token token, std::shared_ptr<loop> parent, std::unique_ptr<char[], deleter> dt = {nullptr, nullptr}, unsigned int len = {});
 
     int send(uv_udp_t *hndl, const struct sockaddr *addr);
+    int send(uv_udp_t *hndl, const uv_buf_t *bufs, unsigned int nbufs, const struct sockaddr *addr);
 
 private:
     std::unique_ptr<char[], deleter> data;
@@ -79,8 +127,40 @@ private:
  * [documentation](http://docs.libuv.org/en/v1.x/udp.html#c.uv_udp_init_ex)
  * for further details.
  */
-class udp_handle final: public handle<udp_handle, uv_udp_t, send_event, udp_data_event> {
-    static void recv_callback(uv_udp_t *hndl, ssize_t nread, const uv_buf_t *buf, const sockaddr *addr, unsigned flags);
+class udp_handle final: public handle<udp_handle, uv_udp_t, send_event, udp_data_event, udp_batch_event> {
+    static constexpr std::size_t DGRAM_MAX_SIZE = 64u * 1024u;
+
+    static void batch_alloc_callback(uv_handle_t *hndl, std::size_t suggested, uv_buf_t *buf);
+    static void recv_batch_callback(uv_udp_t *hndl, ssize_t nread, const uv_buf_t *buf, const sockaddr *addr, unsigned flags);
+
+    template<bool Pooled, typename Handler = void>
+    static void recv_callback(uv_udp_t *hndl, ssize_t nread, const uv_buf_t *buf, const sockaddr *addr, unsigned flags) {
+        udp_handle &udp = *(static_cast<udp_handle *>(hndl->data));
+
+        if(flags & UV_UDP_MMSG_CHUNK) {
+            // chunks are slices of a buffer released later on, data events get their own copy
+            auto data = udp.parent().buffers().acquire(static_cast<std::size_t>(nread));
+            std::memcpy(data.get(), buf->base, static_cast<std::size_t>(nread));
+            udp.dispatch<Handler>(udp_data_event{raw_socket_address{*addr}, std::move(data), static_cast<std::size_t>(nread), !(0 == (flags & UV_UDP_PARTIAL))});
+            return;
+        }
+
+        // data will be destroyed (or given back to the pool) no matter of what the value of nread is
+        std::unique_ptr<char[], buffer_deleter> data{buf->base, buffer_deleter{Pooled}};
+
+        if(nread > 0) {
+            // data available (can be truncated)
+            udp.dispatch<Handler>(udp_data_event{raw_socket_address{*addr}, std::move(data), static_cast<std::size_t>(nread), !(0 == (flags & UV_UDP_PARTIAL))});
+        } else if(nread == 0 && addr == nullptr) {
+            // no more data to be read, doing nothing is fine
+        } else if(nread == 0 && addr != nullptr) {
+            // empty udp packet
+            udp.dispatch<Handler>(udp_data_event{raw_socket_address{*addr}, std::move(data), static_cast<std::size_t>(nread), false});
+        } else {
+            // transmission error
+            udp.dispatch<Handler>(error_event(nread));
+        }
+    }
 
 public:
     using membership = details::uvw_membership;
@@ -180,6 +260,7 @@ public:
      * * `udp_handle::udp_flags::IPV6ONLY`
      * * `udp_handle::udp_flags::UDP_PARTIAL`
      * * `udp_handle::udp_flags::REUSEADDR`
+     * * `udp_handle::udp_flags::REUSEPORT`
      * * `udp_handle::udp_flags::UDP_MMSG_CHUNK`
      * * `udp_handle::udp_flags::UDP_MMSG_FREE`
      * * `udp_handle::udp_flags::UDP_LINUX_RECVERR`
@@ -203,6 +284,7 @@ public:
      * * `udp_handle::udp_flags::IPV6ONLY`
      * * `udp_handle::udp_flags::UDP_PARTIAL`
      * * `udp_handle::udp_flags::REUSEADDR`
+     * * `udp_handle::udp_flags::REUSEPORT`
      * * `udp_handle::udp_flags::UDP_MMSG_CHUNK`
      * * `udp_handle::udp_flags::UDP_MMSG_FREE`
      * * `udp_handle::udp_flags::UDP_LINUX_RECVERR`
@@ -227,6 +309,7 @@ public:
      * * `udp_handle::udp_flags::IPV6ONLY`
      * * `udp_handle::udp_flags::UDP_PARTIAL`
      * * `udp_handle::udp_flags::REUSEADDR`
+     * * `udp_handle::udp_flags::REUSEPORT`
      * * `udp_handle::udp_flags::UDP_MMSG_CHUNK`
      * * `udp_handle::udp_flags::UDP_MMSG_FREE`
      * * `udp_handle::udp_flags::UDP_LINUX_RECVERR`
@@ -360,6 +443,25 @@ public:
      */
     int send(const socket_address &addr, std::unique_ptr<char[]> data, unsigned int len);
 
+    /**
+     * @brief Sends data over the UDP socket.
+     *
+     * Note that if the socket has not previously been bound with `bind()`, it
+     * will be bound to `0.0.0.0` (the _all interfaces_ IPv4 address) and a
+     * random port number.
+     *
+     * The handle takes the ownership of the data and it is in charge of delete
+     * them.
+     *
+     * A send event will be emitted when the data have been sent.
+     *
+     * @param addr A valid instance of raw_socket_address.
+     * @param data The data to be sent.
+     * @param len The lenght of the submitted data.
+     * @return Underlying return value.
+     */
+    int send(const raw_socket_address &addr, std::unique_ptr<char[]> data, unsigned int len);
+
     /**
      * @brief Sends data over the UDP socket.
      *
@@ -418,6 +520,25 @@ public:
      */
     int send(const socket_address &addr, char *data, unsigned int len);
 
+    /**
+     * @brief Sends data over the UDP socket.
+     *
+     * Note that if the socket has not previously been bound with `bind()`, it
+     * will be bound to `0.0.0.0` (the _all interfaces_ IPv4 address) and a
+     * random port number.
+     *
+     * The handle doesn't take the ownership of the data. Be sure that their
+     * lifetime overcome the one of the request.
+     *
+     * A send event will be emitted when the data have been sent.
+     *
+     * @param addr A valid instance of raw_socket_address.
+     * @param data The data to be sent.
+     * @param len The lenght of the submitted data.
+     * @return Underlying return value.
+     */
+    int send(const raw_socket_address &addr, char *data, unsigned int len);
+
     /**
      * @brief Sends data over the UDP socket.
      *
@@ -458,6 +579,19 @@ public:
      */
     int try_send(const socket_address &addr, std::unique_ptr<char[]> data, unsigned int len);
 
+    /**
+     * @brief Sends data over the UDP socket.
+     *
+     * Same as `send()`, but it won’t queue a send request if it can’t be
+     * completed immediately.
+     *
+     * @param addr A valid instance of raw_socket_address.
+     * @param data The data to be sent.
+     * @param len The lenght of the submitted data.
+     * @return Underlying return value.
+     */
+    int try_send(const raw_socket_address &addr, std::unique_ptr<char[]> data, unsigned int len);
+
     /**
      * @brief Sends data over the UDP socket.
      *
@@ -498,6 +632,63 @@ public:
      */
     int try_send(const socket_address &addr, char *data, unsigned int len);
 
+    /**
+     * @brief Sends data over the UDP socket.
+     *
+     * Same as `send()`, but it won’t queue a send request if it can’t be
+     * completed immediately.
+     *
+     * @param addr A valid instance of raw_socket_address.
+     * @param data The data to be sent.
+     * @param len The lenght of the submitted data.
+     * @return Underlying return value.
+     */
+    int try_send(const raw_socket_address &addr, char *data, unsigned int len);
+
+    /**
+     * @brief Sends a batch of messages over the UDP socket.
+     *
+     * Messages are sent right away with as few system calls as possible (see
+     * `try_send_batch`). Those that can't be sent immediately are queued and
+     * a send event will be emitted for each of them once sent.
+     *
+     * Messages are handled in order. If a message can't be queued, the ones
+     * that precede it are still sent and the returned value reports the
+     * partial progress. The rest can be submitted again later on.
+     *
+     * The handle doesn't take the ownership of the data. Be sure that their
+     * lifetime overcome the one of the requests.
+     *
+     * @param msgs The messages to be sent.
+     * @param count The number of messages.
+     * @return The number of messages sent or queued, or an error code if none
+     * of them can be sent nor queued.
+     */
+    int send_batch(const udp_message *msgs, std::size_t count);
+
+    /**
+     * @brief Sends a batch of messages over the UDP socket.
+     *
+     * Same as `send_batch()`, but it won’t queue send requests for messages
+     * that can’t be sent immediately.<br/>
+     * Like `try_send()`, if the socket has not previously been bound with
+     * `bind()` it is bound to the _all interfaces_ address of the family of
+     * the first message and a random port number.<br/>
+     * Messages are sent in order and the returned value reports the partial
+     * progress. The messages that haven't been sent can be submitted again
+     * later on.
+     *
+     * See the official
+     * [documentation](http://docs.libuv.org/en/v1.x/udp.html#c.uv_udp_try_send2)
+     * for further details.
+     *
+     * @param msgs The messages to be sent.
+     * @param count The number of messages.
+     * @return The number of messages sent or an error code if none of them
+     * can be sent.
+     */
+    int try_send_batch(const udp_message *msgs, std::size_t count);
+
     /**
      * @brief Prepares for receiving data.
      *
@@ -507,6 +698,10 @@ public:
      *
      * An UDP data event will be emitted when the handle receives data.
      *
+     * Buffers are taken from the pool of the loop (see `loop::buffers()`) and
+     * given back to it when data events are destroyed. Therefore, data events
+     * must be destroyed on the thread that runs the loop.
+     *
      * @return Underlying return value.
      */
     int recv();
@@ -519,9 +714,43 @@ public:
      */
     template<auto Alloc>
     int recv() {
-        return uv_udp_recv_start(raw(), &details::common_alloc_callback<udp_handle, Alloc>, &recv_callback);
+        return uv_udp_recv_start(raw(), &details::common_alloc_callback<udp_handle, Alloc>, &recv_callback<false>);
     }
 
+    /**
+     * @brief Prepares for receiving data.
+     * @sa recv
+     * @tparam Handler Type to which UDP data and error events are dispatched.
+     * @return Underlying return value.
+     */
+    template<typename Handler>
+    int recv(static_handler<Handler>) {
+        return uv_udp_recv_start(raw(), &details::pool_alloc_callback<udp_handle>, &recv_callback<true, Handler>);
+    }
+
+    /**
+     * @brief Prepares for receiving data in batches.
+     *
+     * Note that if the socket has not previously been bound with `bind()`, it
+     * is bound to `0.0.0.0` (the _all interfaces_ IPv4 address) and a random
+     * port number.
+     *
+     * An UDP batch event will be emitted for each `recvmmsg` call, with all
+     * the datagrams received by it. Datagrams share a receive buffer that the
+     * handle allocates once and reuses for all the batches, no allocations
+     * occur per datagram nor per batch.<br/>
+     * The handle must be initialized with `udp_flags::UDP_RECVMMSG` and the
+     * platform must support `recvmmsg`. Otherwise, every event carries a
+     * single datagram.
+     *
+     * Note that `libuv` caps the number of datagrams read at once, larger
+     * batches don't result in more datagrams per event.
+     *
+     * @param count The maximum number of datagrams per batch.
+     * @return Underlying return value.
+     */
+    int recv_batch(std::size_t count = 16u);
+
     /**
      * @brief Stops listening for incoming datagrams.
      * @return Underlying return value.
@@ -551,6 +780,10 @@ private:
     } tag{DEFAULT};
 
     unsigned int flags{};
+    std::size_t batch_size{};
+    std::size_t batch_capacity{};
+    std::unique_ptr<char[]> batch_buffer{};
+    std::vector<udp_datagram> batch{};
 };
 
 } // namespace uvw
@@ -1,14 +1,20 @@
+#include <algorithm>
 #include <array>
+#include <utility>
+#include <vector>
 #include "config.h"
 
 namespace uvw {
 
-UVW_INLINE udp_data_event::udp_data_event(socket_address sndr, std::unique_ptr<char[]> buf, std::size_t len, bool part) noexcept
+UVW_INLINE udp_data_event::udp_data_event(raw_socket_address sndr, std::unique_ptr<char[], buffer_deleter> buf, std::size_t len, bool part) noexcept
     : data{std::move(buf)},
       length{len},
-      sender{std::move(sndr)},
+      sender{sndr},
       partial{part} {}
 
+UVW_INLINE udp_batch_event::udp_batch_event(const std::vector<udp_datagram> &msgs) noexcept
+    : datagrams{msgs} {}
+
 UVW_INLINE void details::send_req::udp_send_callback(uv_udp_send_t *req, int status) {
     if(auto ptr = reserve(req); status) {
         ptr->publish(error_event{status});
@@ -26,20 +32,48 @@ UVW_INLINE int details::send_req::send(uv_udp_t *hndl, const struct sockaddr *ad
     return this->leak_if(uv_udp_send(raw(), hndl, &buf, 1, addr, &udp_send_callback));
 }
 
-UVW_INLINE void udp_handle::recv_callback(uv_udp_t *hndl, ssize_t nread, const uv_buf_t *buf, const sockaddr *addr, unsigned flags) {
+UVW_INLINE int details::send_req::send(uv_udp_t *hndl, const uv_buf_t *bufs, unsigned int nbufs, const struct sockaddr *addr) {
+    return this->leak_if(uv_udp_send(raw(), hndl, bufs, nbufs, addr, &udp_send_callback));
+}
+
+UVW_INLINE void udp_handle::batch_alloc_callback(uv_handle_t *hndl, std::size_t suggested, uv_buf_t *buf) {
     udp_handle &udp = *(static_cast<udp_handle *>(hndl->data));
-    // data will be destroyed no matter of what the value of nread is
-    std::unique_ptr<char[]> data{buf->base};
-
-    if(nread > 0) {
-        // data available (can be truncated)
-        udp.publish(udp_data_event{details::sock_addr(*addr), std::move(data), static_cast<std::size_t>(nread), !(0 == (flags & UV_UDP_PARTIAL))});
-    } else if(nread == 0 && addr == nullptr) {
-        // no more data to be read, doing nothing is fine
-    } else if(nread == 0 && addr != nullptr) {
-        // empty udp packet
-        udp.publish(udp_data_event{details::sock_addr(*addr), std::move(data), static_cast<std::size_t>(nread), false});
-    } else {
+
+    if(uv_udp_using_recvmmsg(udp.raw())) {
+        // recvmmsg slices the buffer in chunks of the maximum size of a datagram
+        suggested = udp.batch_size * DGRAM_MAX_SIZE;
+        udp.batch.reserve(udp.batch_size);
+    }
+
+    // libuv is done with the previous batch by the time it asks for a buffer
+    if(udp.batch_capacity < suggested) {
+        udp.batch_buffer = std::make_unique<char[]>(suggested);
+        udp.batch_capacity = suggested;
+    }
+
+    *buf = uv_buf_init(udp.batch_buffer.get(), static_cast<unsigned int>(udp.batch_capacity));
+}
+
+UVW_INLINE void udp_handle::recv_batch_callback(uv_udp_t *hndl, ssize_t nread, const uv_buf_t *buf, const sockaddr *addr, unsigned flags) {
+    udp_handle &udp = *(static_cast<udp_handle *>(hndl->data));
+
+    if(flags & UV_UDP_MMSG_CHUNK) {
+        // chunks are published all together once libuv is done with the buffer
+        udp.batch.push_back(udp_datagram{buf->base, static_cast<std::size_t>(nread), raw_socket_address{*addr}, !(0 == (flags & UV_UDP_PARTIAL))});
+        return;
+    }
+
+    if(flags & UV_UDP_MMSG_FREE) {
+        if(!udp.batch.empty()) {
+            udp.publish(udp_batch_event{udp.batch});
+            udp.batch.clear();
+        }
+    } else if(nread > 0 || (nread == 0 && addr != nullptr)) {
+        // recvmmsg isn't in use, batches of a single datagram
+        udp.batch.assign(1u, udp_datagram{buf->base, static_cast<std::size_t>(nread), raw_socket_address{*addr}, !(0 == (flags & UV_UDP_PARTIAL))});
+        udp.publish(udp_batch_event{udp.batch});
+        udp.batch.clear();
+    } else if(nread < 0) {
         // transmission error
         udp.publish(error_event(nread));
     }
@@ -127,9 +161,9 @@ UVW_INLINE bool udp_handle::ttl(int val) {
 }
 
 UVW_INLINE int udp_handle::send(const sockaddr &addr, std::unique_ptr<char[]> data, unsigned int len) {
-    auto req = parent().resource<details::send_req>(std::unique_ptr<char[], details::send_req::deleter>{data.release(), [](char *ptr) { delete[] ptr; }}, len);
+    auto req = parent().recycled_resource<details::send_req>(std::unique_ptr<char[], details::send_req::deleter>{data.release(), [](char *ptr) { delete[] ptr; }}, len);
 
-    auto listener = [ptr = shared_from_this()](const auto &event, const auto &) {
+    auto listener = [ptr = this](const auto &event, const auto &) {
         ptr->publish(event);
     };
 
@@ -147,10 +181,14 @@ UVW_INLINE int udp_handle::send(const socket_address &addr, std::unique_ptr<char
     return send(addr.ip, addr.port, std::move(data), len);
 }
 
+UVW_INLINE int udp_handle::send(const raw_socket_address &addr, std::unique_ptr<char[]> data, unsigned int len) {
+    return send(*addr.raw(), std::move(data), len);
+}
+
 UVW_INLINE int udp_handle::send(const sockaddr &addr, char *data, unsigned int len) {
-    auto req = parent().resource<details::send_req>(std::unique_ptr<char[], details::send_req::deleter>{data, [](char *) {}}, len);
+    auto req = parent().recycled_resource<details::send_req>(std::unique_ptr<char[], details::send_req::deleter>{data, [](char *) {}}, len);
 
-    auto listener = [ptr = shared_from_this()](const auto &event, const auto &) {
+    auto listener = [ptr = this](const auto &event, const auto &) {
         ptr->publish(event);
     };
 
@@ -168,6 +206,10 @@ UVW_INLINE int udp_handle::send(const socket_address &addr, char *data, unsigned
     return send(addr.ip, addr.port, data, len);
 }
 
+UVW_INLINE int udp_handle::send(const raw_socket_address &addr, char *data, unsigned int len) {
+    return send(*addr.raw(), data, len);
+}
+
 UVW_INLINE int udp_handle::try_send(const sockaddr &addr, std::unique_ptr<char[]> data, unsigned int len) {
     std::array bufs{uv_buf_init(data.get(), len)};
     return uv_udp_try_send(raw(), bufs.data(), 1, &addr);
@@ -181,6 +223,10 @@ UVW_INLINE int udp_handle::try_send(const socket_address &addr, std::unique_ptr<
     return try_send(addr.ip, addr.port, std::move(data), len);
 }
 
+UVW_INLINE int udp_handle::try_send(const raw_socket_address &addr, std::unique_ptr<char[]> data, unsigned int len) {
+    return try_send(*addr.raw(), std::move(data), len);
+}
+
 UVW_INLINE int udp_handle::try_send(const sockaddr &addr, char *data, unsigned int len) {
     std::array bufs{uv_buf_init(data, len)};
     return uv_udp_try_send(raw(), bufs.data(), 1, &addr);
@@ -194,8 +240,97 @@ UVW_INLINE int udp_handle::try_send(const socket_address &addr, char *data, unsi
     return try_send(addr.ip, addr.port, data, len);
 }
 
+UVW_INLINE int udp_handle::try_send(const raw_socket_address &addr, char *data, unsigned int len) {
+    return try_send(*addr.raw(), data, len);
+}
+
+UVW_INLINE int udp_handle::send_batch(const udp_message *msgs, std::size_t count) {
+    auto sent = try_send_batch(msgs, count);
+
+    if(sent < 0 && sent != UV_EAGAIN) {
+        return sent;
+    }
+
+    const auto offset = static_cast<std::size_t>(sent < 0 ? 0 : sent);
+
+    auto listener = [ptr = this](const auto &event, const auto &) {
+        ptr->publish(event);
+    };
+
+    for(auto next = offset; next < count; ++next) {
+        auto req = parent().recycled_resource<details::send_req>();
+        req->on<error_event>(listener);
+        req->on<send_event>(listener);
+
+        const auto &msg = msgs[next];
+        const auto *addr = (msg.address.family() == AF_UNSPEC) ? nullptr : msg.address.raw();
+
+        if(auto err = req->send(raw(), msg.bufs, msg.nbufs, addr); err) {
+            // messages sent or queued so far aren't affected
+            return next ? static_cast<int>(next) : err;
+        }
+    }
+
+    return static_cast<int>(count);
+}
+
+UVW_INLINE int udp_handle::try_send_batch(const udp_message *msgs, std::size_t count) {
+    constexpr std::size_t chunk = 64u;
+
+    std::array<uv_buf_t *, chunk> bufs{};
+    std::array<unsigned int, chunk> nbufs{};
+    std::array<sockaddr *, chunk> addrs{};
+    std::size_t sent{};
+
+    if(uv_os_fd_t fd; count && !closing() && uv_fileno(reinterpret_cast<const uv_handle_t *>(raw()), &fd) == UV_EBADF) {
+        // unlike uv_udp_try_send, uv_udp_try_send2 doesn't bind implicitly
+        const auto family = msgs->address.family();
+
+        if(family == AF_INET || family == AF_INET6) {
+            if(const auto err = bind((family == AF_INET6) ? "::" : "0.0.0.0", 0u); err) {
+                return err;
+            }
+        }
+    }
+
+    while(sent < count) {
+        const auto len = std::min(count - sent, chunk);
+
+        for(std::size_t pos{}; pos < len; ++pos) {
+            const auto &msg = msgs[sent + pos];
+            bufs[pos] = msg.bufs;
+            nbufs[pos] = msg.nbufs;
+            // libuv doesn't modify the addresses, it's just a matter of signature
+            addrs[pos] = (msg.address.family() == AF_UNSPEC) ? nullptr : const_cast<sockaddr *>(msg.address.raw());
+        }
+
+        const auto ret = uv_udp_try_send2(raw(), static_cast<unsigned int>(len), bufs.data(), nbufs.data(), addrs.data(), 0);
+
+        if(ret < 0) {
+            return sent ? static_cast<int>(sent) : ret;
+        }
+
+        sent += static_cast<std::size_t>(ret);
+
+        if(static_cast<std::size_t>(ret) < len) {
+            break;
+        }
+    }
+
+    return static_cast<int>(sent);
+}
+
 UVW_INLINE int udp_handle::recv() {
-    return uv_udp_recv_start(raw(), &details::common_alloc_callback, &recv_callback);
+    return uv_udp_recv_start(raw(), &details::pool_alloc_callback<udp_handle>, &recv_callback<true>);
+}
+
+UVW_INLINE int udp_handle::recv_batch(std::size_t count) {
+    if(count == 0u) {
+        return UV_EINVAL;
+    }
+
+    batch_size = count;
+    return uv_udp_recv_start(raw(), &batch_alloc_callback, &recv_batch_callback);
 }
 
 UVW_INLINE int udp_handle::stop() {
@@ -216,6 +216,68 @@ struct socket_address {
     unsigned int port; /*!< A valid service identifier. */
 };
 
+/**
+ * @brief Raw address representation.
+ *
+ * Trivially copyable wrapper around a `sockaddr_storage`. Unlike
+ * `socket_address`, the address is formatted only on demand, therefore it's
+ * cheap to create and to copy around.
+ */
+struct raw_socket_address {
+    /*! @brief Default constructor, the family is `AF_UNSPEC`. */
+    raw_socket_address() noexcept;
+
+    /**
+     * @brief Constructs an address from a `sockaddr` data structure.
+     * @param addr Initialized `sockaddr_in` or `sockaddr_in6` data structure.
+     */
+    explicit raw_socket_address(const sockaddr &addr) noexcept;
+
+    /**
+     * @brief Constructs an address from an IP and a port.
+     *
+     * The family is `AF_UNSPEC` if the IP isn't a valid IPv4 or IPv6.
+     *
+     * @param ip Either an IPv4 or an IPv6.
+     * @param port A valid service identifier.
+     */
+    raw_socket_address(const std::string &ip, unsigned int port) noexcept;
+
+    /**
+     * @brief Gets the family of the address.
+     * @return Either `AF_INET`, `AF_INET6` or `AF_UNSPEC`.
+     */
+    [[nodiscard]] int family() const noexcept;
+
+    /**
+     * @brief Gets the port of the address.
+     * @return A valid service identifier, 0 for invalid addresses.
+     */
+    [[nodiscard]] unsigned int port() const noexcept;
+
+    /**
+     * @brief Formats the IP of the address.
+     * @return Either an IPv4 or an IPv6, an empty string for invalid addresses.
+     */
+    [[nodiscard]] std::string ip() const;
+
+    /**
+     * @brief Formats the address.
+     * @return A valid instance of socket_address.
+     */
+    [[nodiscard]] socket_address address() const;
+
+    /**
+     * @brief Gets the underlying address.
+     * @return A pointer to an initialized `sockaddr_in` or `sockaddr_in6`
+     * data structure, depending on the family.
+     */
+    [[nodiscard]] const sockaddr *raw() const noexcept;
+
+private:
+    sockaddr_storage storage;
+};
+
 /**
  * \brief CPU information.
  */
@@ -270,8 +332,6 @@ template<typename F, typename... Args>
     return str;
 }
 
-void common_alloc_callback(uv_handle_t *, std::size_t suggested, uv_buf_t *buf);
-
 template<typename Type, auto Alloc>
 void common_alloc_callback(uv_handle_t *handle, std::size_t suggested, uv_buf_t *buf) {
     auto [alloc, size] = Alloc(*static_cast<const Type *>(handle->data), suggested);
@@ -1,7 +1,56 @@
+#include <cstring>
 #include "config.h"
 
 namespace uvw {
 
+UVW_INLINE raw_socket_address::raw_socket_address() noexcept
+    : storage{} {}
+
+UVW_INLINE raw_socket_address::raw_socket_address(const sockaddr &addr) noexcept
+    : storage{} {
+    if(addr.sa_family == AF_INET) {
+        std::memcpy(&storage, &addr, sizeof(sockaddr_in));
+    } else if(addr.sa_family == AF_INET6) {
+        std::memcpy(&storage, &addr, sizeof(sockaddr_in6));
+    }
+}
+
+UVW_INLINE raw_socket_address::raw_socket_address(const std::string &ip, unsigned int port) noexcept
+    : storage{} {
+    // explicitly cast to avoid `-Wsign-conversion` warnings
+    auto signed_port = static_cast<int>(port);
+
+    if(uv_ip4_addr(ip.data(), signed_port, reinterpret_cast<sockaddr_in *>(&storage)) != 0 && uv_ip6_addr(ip.data(), signed_port, reinterpret_cast<sockaddr_in6 *>(&storage)) != 0) {
+        storage = sockaddr_storage{};
+    }
+}
+
+UVW_INLINE int raw_socket_address::family() const noexcept {
+    return storage.ss_family;
+}
+
+UVW_INLINE unsigned int raw_socket_address::port() const noexcept {
+    if(storage.ss_family == AF_INET) {
+        return ntohs(reinterpret_cast<const sockaddr_in &>(storage).sin_port);
+    } else if(storage.ss_family == AF_INET6) {
+        return ntohs(reinterpret_cast<const sockaddr_in6 &>(storage).sin6_port);
+    }
+
+    return 0u;
+}
+
+UVW_INLINE std::string raw_socket_address::ip() const {
+    return address().ip;
+}
+
+UVW_INLINE socket_address raw_socket_address::address() const {
+    return details::sock_addr(storage);
+}
+
+UVW_INLINE const sockaddr *raw_socket_address::raw() const noexcept {
+    return reinterpret_cast<const sockaddr *>(&storage);
+}
+
 UVW_INLINE passwd_info::passwd_info(std::shared_ptr<uv_passwd_t> pwd)
     : value{std::move(pwd)} {}
 
@@ -50,11 +99,6 @@ UVW_INLINE std::string uts_name::machine() const noexcept {
 
 namespace details {
 
-UVW_INLINE void common_alloc_callback(uv_handle_t *, std::size_t suggested, uv_buf_t *buf) {
-    auto size = static_cast<unsigned int>(suggested);
-    *buf = uv_buf_init(new char[size], size);
-}
-
 UVW_INLINE sockaddr ip_addr(const char *addr, unsigned int port) {
     // explicitly cast to avoid `-Wsign-conversion` warnings
     // libuv internally just casts to an `unsigned short` anyway
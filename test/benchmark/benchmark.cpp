@@ -0,0 +1,454 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <uvw/file_stream.h>
+#include <uvw/fs.h>
+#include <uvw/fs_walker.h>
+#include <uvw/loop.h>
+#include <uvw/tcp.h>
+#include <uvw/udp.h>
+
+std::atomic<std::size_t> allocations{};
+
+void *operator new(std::size_t size) {
+    allocations.fetch_add(1u, std::memory_order_relaxed);
+
+    if(auto *ptr = std::malloc(size ? size : 1u); ptr) {
+        return ptr;
+    }
+
+    throw std::bad_alloc{};
+}
+
+// GCC can't tell that the replaced operators match once they are inlined
+#if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic pop
+#endif
+
+struct timer final {
+    timer()
+        : start{std::chrono::steady_clock::now()} {}
+
+    void elapsed(std::size_t count, const char *what = "datagrams") {
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << seconds << " seconds, " << static_cast<std::size_t>(static_cast<double>(count) / seconds) << " " << what << " per second" << std::endl;
+    }
+
+private:
+    std::chrono::time_point<std::chrono::steady_clock> start;
+};
+
+inline constexpr std::size_t datagrams = 200000u;
+inline constexpr std::size_t chunk = 64u;
+
+template<typename Func>
+void udp_send(Func func) {
+    const std::string address = std::string{"127.0.0.1"};
+    const unsigned int port = 4242;
+
+    auto loop = uvw::loop::get_default();
+    auto server = loop->resource<uvw::udp_handle>();
+    auto client = loop->resource<uvw::udp_handle>();
+
+    server->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+    client->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    client->on<uvw::send_event>([&server](const uvw::send_event &, uvw::udp_handle &handle) {
+        if(handle.send_queue_count() == 0u) {
+            server->close();
+            handle.close();
+        }
+    });
+
+    ASSERT_EQ(0, (server->bind(address, port)));
+    ASSERT_EQ(0, (client->bind(address, 0u)));
+
+    std::array<char, 64u> data{};
+    auto buf = uv_buf_init(data.data(), static_cast<unsigned int>(data.size()));
+    std::vector<uvw::udp_message> msgs(chunk, uvw::udp_message{uvw::raw_socket_address{address, port}, &buf, 1u});
+
+    timer timer;
+    func(*client, msgs);
+
+    if(client->send_queue_count() == 0u) {
+        server->close();
+        client->close();
+    }
+
+    loop->run();
+    timer.elapsed(datagrams);
+}
+
+TEST(Benchmark, UDPTrySend) {
+    std::cout << "Sending " << datagrams << " datagrams one at a time, dropping those that can't be sent" << std::endl;
+
+    udp_send([](uvw::udp_handle &handle, const std::vector<uvw::udp_message> &msgs) {
+        for(std::size_t pos{}; pos < datagrams; ++pos) {
+            handle.try_send(msgs[0u].address, msgs[0u].bufs->base, static_cast<unsigned int>(msgs[0u].bufs->len));
+        }
+    });
+}
+
+TEST(Benchmark, UDPTrySendBatch) {
+    std::cout << "Sending " << datagrams << " datagrams in batches of " << chunk << ", dropping those that can't be sent" << std::endl;
+
+    udp_send([](uvw::udp_handle &handle, const std::vector<uvw::udp_message> &msgs) {
+        for(std::size_t pos{}; pos < datagrams; pos += chunk) {
+            handle.try_send_batch(msgs.data(), msgs.size());
+        }
+    });
+}
+
+TEST(Benchmark, UDPSend) {
+    std::cout << "Sending " << datagrams << " datagrams one at a time" << std::endl;
+
+    udp_send([](uvw::udp_handle &handle, const std::vector<uvw::udp_message> &msgs) {
+        for(std::size_t pos{}; pos < datagrams; ++pos) {
+            ASSERT_EQ(0, handle.send(msgs[0u].address, msgs[0u].bufs->base, static_cast<unsigned int>(msgs[0u].bufs->len)));
+        }
+    });
+}
+
+TEST(Benchmark, UDPSendBatch) {
+    std::cout << "Sending " << datagrams << " datagrams in batches of " << chunk << std::endl;
+
+    udp_send([](uvw::udp_handle &handle, const std::vector<uvw::udp_message> &msgs) {
+        for(std::size_t pos{}; pos < datagrams; pos += chunk) {
+            ASSERT_EQ(static_cast<int>(msgs.size()), handle.send_batch(msgs.data(), msgs.size()));
+        }
+    });
+}
+
+inline constexpr std::size_t writes = 100000u;
+
+template<typename Func>
+void tcp_write(Func func) {
+    const std::string address = std::string{"127.0.0.1"};
+    const unsigned int port = 4242;
+
+    auto loop = uvw::loop::get_default();
+    auto server = loop->resource<uvw::tcp_handle>();
+    auto client = loop->resource<uvw::tcp_handle>();
+
+    std::array<char, 64u> data{};
+    std::function<void(uvw::tcp_handle &)> next{};
+    std::size_t count{};
+    std::size_t before{};
+
+    server->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+    client->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    server->on<uvw::listen_event>([](const uvw::listen_event &, uvw::tcp_handle &handle) {
+        const std::shared_ptr<uvw::tcp_handle> socket = handle.parent().resource<uvw::tcp_handle>();
+
+        socket->on<uvw::close_event>([&handle](const uvw::close_event &, uvw::tcp_handle &) { handle.close(); });
+        socket->on<uvw::end_event>([](const uvw::end_event &, uvw::tcp_handle &sock) { sock.close(); });
+
+        ASSERT_EQ(0, handle.accept(*socket));
+        ASSERT_EQ(0, socket->read());
+    });
+
+    // writes are issued one at a time, each one once the previous one is complete
+    next = [&](uvw::tcp_handle &handle) {
+        if(count++ == writes) {
+            const auto total = allocations.load(std::memory_order_relaxed) - before;
+            std::cout << static_cast<double>(total) / static_cast<double>(writes) << " allocations per write" << std::endl;
+            handle.close();
+        } else {
+            ASSERT_EQ(0, func(handle, data.data(), static_cast<unsigned int>(data.size()), next));
+        }
+    };
+
+    client->on<uvw::write_event>([&next](const uvw::write_event &, uvw::tcp_handle &handle) { next(handle); });
+
+    client->on<uvw::connect_event>([&](const uvw::connect_event &, uvw::tcp_handle &handle) {
+        // the first round warms up the pools
+        ASSERT_EQ(0, func(handle, data.data(), static_cast<unsigned int>(data.size()), next));
+        before = allocations.load(std::memory_order_relaxed);
+    });
+
+    ASSERT_EQ(0, (server->bind(address, port)));
+    ASSERT_EQ(0, server->listen());
+    ASSERT_EQ(0, (client->connect(address, port)));
+
+    timer timer;
+    loop->run();
+    timer.elapsed(writes, "writes");
+}
+
+TEST(Benchmark, TCPWritePooled) {
+    std::cout << "Writing " << writes << " buffers one at a time, requests are recycled through the loop" << std::endl;
+
+    tcp_write([](uvw::tcp_handle &handle, char *data, unsigned int len, const auto &) {
+        return handle.write(data, len);
+    });
+}
+
+TEST(Benchmark, TCPWriteUnpooled) {
+    std::cout << "Writing " << writes << " buffers one at a time, requests are allocated on the heap" << std::endl;
+
+    tcp_write([](uvw::tcp_handle &handle, char *data, unsigned int len, const auto &next) {
+        using request_type = uvw::details::write_req<void (*)(char *)>;
+
+        // what writes did before requests were recycled, listeners kept the handle alive
+        auto req = handle.parent().resource<request_type>(std::unique_ptr<char[], void (*)(char *)>{data, [](char *) {}}, len);
+        req->on<uvw::write_event>([&next, ptr = handle.shared_from_this()](const uvw::write_event &, request_type &) { next(*ptr); });
+        return req->write(reinterpret_cast<uv_stream_t *>(handle.raw()));
+    });
+}
+
+const std::string tree = std::string{TARGET_BENCHMARK_DIR} + std::string{"/tree"};
+
+inline constexpr std::size_t fanout = 10u;
+inline constexpr std::size_t files = 1000u;
+
+// root/d{0..9}/d{0..9}/f{0..999}, generated once and reused across runs
+void generate(uvw::loop &loop) {
+    static constexpr auto mode_0644 = 0644;
+    static constexpr auto mode_0755 = 0755;
+
+    auto req = loop.resource<uvw::fs_req>();
+    auto file = loop.resource<uvw::file_req>();
+    auto flags = uvw::file_req::file_open_flags::CREAT | uvw::file_req::file_open_flags::WRONLY;
+
+    if(!req->stat_sync(tree).first) {
+        std::cout << "Generating " << fanout * fanout * files << " files under " << tree << std::endl;
+
+        ASSERT_TRUE(req->mkdir_sync(tree, mode_0755));
+
+        for(std::size_t outer{}; outer < fanout; ++outer) {
+            const auto parent = tree + "/d" + std::to_string(outer);
+            ASSERT_TRUE(req->mkdir_sync(parent, mode_0755));
+
+            for(std::size_t inner{}; inner < fanout; ++inner) {
+                const auto path = parent + "/d" + std::to_string(inner);
+                ASSERT_TRUE(req->mkdir_sync(path, mode_0755));
+
+                for(std::size_t pos{}; pos < files; ++pos) {
+                    ASSERT_TRUE(file->open_sync(path + "/f" + std::to_string(pos), flags, mode_0644));
+                    ASSERT_TRUE(file->close_sync());
+                }
+            }
+        }
+    }
+}
+
+// the directory stream lives within its request, entries are stat'ed through another one
+std::size_t walk_sync(uvw::fs_req &dir, uvw::fs_req &entry, const std::string &path, bool info) {
+    std::vector<std::string> children{};
+    std::size_t count{};
+
+    if(!dir.opendir_sync(path)) {
+        ADD_FAILURE();
+        return count;
+    }
+
+    for(auto read = dir.readdir_sync(chunk); read.first; read = dir.readdir_sync(chunk)) {
+        for(std::size_t pos{}; pos < read.second.second; ++pos) {
+            const auto &curr = read.second.first[pos];
+            auto child = path + "/" + curr.name;
+
+            if(info) {
+                entry.lstat_sync(child);
+            }
+
+            if(curr.type == UV_DIRENT_DIR) {
+                children.push_back(std::move(child));
+            }
+
+            ++count;
+        }
+    }
+
+    dir.closedir_sync();
+
+    for(auto &&child: children) {
+        count += walk_sync(dir, entry, child, info);
+    }
+
+    return count;
+}
+
+void fs_walk_sync(bool info) {
+    auto loop = uvw::loop::get_default();
+    auto dir = loop->resource<uvw::fs_req>();
+    auto entry = loop->resource<uvw::fs_req>();
+
+    generate(*loop);
+
+    timer timer;
+    const auto count = walk_sync(*dir, *entry, tree, info);
+    timer.elapsed(count, "entries");
+
+    ASSERT_EQ(count, fanout * fanout * files + fanout * fanout + fanout);
+}
+
+void fs_walk(bool info) {
+    auto loop = uvw::loop::get_default();
+
+    generate(*loop);
+
+    for(std::size_t concurrency: {1u, 4u, 16u}) {
+        auto walker = loop->resource<uvw::fs_walker>();
+        std::size_t count{};
+
+        walker->concurrency(concurrency);
+        walker->stat(info);
+
+        walker->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+        walker->on<uvw::fs_walk_event>([&count](const uvw::fs_walk_event &event, auto &) { count += event.entries.size(); });
+
+        std::cout << "Concurrency " << concurrency << ": ";
+
+        timer timer;
+        ASSERT_EQ(0, walker->start(tree));
+        loop->run();
+        timer.elapsed(count, "entries");
+
+        ASSERT_EQ(count, fanout * fanout * files + fanout * fanout + fanout);
+    }
+}
+
+TEST(Benchmark, FsWalkSerial) {
+    std::cout << "Walking the tree with a serial readdir_sync loop" << std::endl;
+    fs_walk_sync(false);
+}
+
+TEST(Benchmark, FsWalkSerialStat) {
+    std::cout << "Walking the tree with a serial readdir_sync loop, entries are stat'ed" << std::endl;
+    fs_walk_sync(true);
+}
+
+TEST(Benchmark, FsWalk) {
+    std::cout << "Walking the tree with a walker" << std::endl;
+    fs_walk(false);
+}
+
+TEST(Benchmark, FsWalkStat) {
+    std::cout << "Walking the tree with a walker, entries are stat'ed" << std::endl;
+    fs_walk(true);
+}
+
+const std::string filename = std::string{TARGET_BENCHMARK_DIR} + std::string{"/stream.file"};
+
+inline constexpr std::size_t megabytes = 256u;
+inline constexpr std::array<std::size_t, 3u> lengths{1u << 16u, 1u << 17u, 1u << 20u};
+inline constexpr std::array<std::size_t, 3u> depths{1u, 4u, 16u};
+
+void file_write(std::size_t length, std::size_t depth) {
+    static constexpr auto mode_0644 = 0644;
+
+    auto loop = uvw::loop::get_default();
+    auto req = loop->resource<uvw::file_req>();
+    auto stream = loop->resource<uvw::file_write_stream>();
+    auto flags = uvw::file_req::file_open_flags::CREAT | uvw::file_req::file_open_flags::WRONLY | uvw::file_req::file_open_flags::TRUNC;
+
+    // data are produced in small pieces and coalesced by the stream
+    std::vector<char> data(1u << 12u, 'x');
+    const std::size_t total = megabytes << 20u;
+    std::size_t written{};
+
+    // backpressure, the producer waits for the stream to drain once enough data are in flight
+    const auto produce = [&](uvw::file_write_stream &hndl) {
+        for(; written < total && hndl.queued() < depth * length; written += data.size()) {
+            ASSERT_EQ(0, hndl.write(data.data(), data.size()));
+        }
+
+        if(written == total) {
+            hndl.end();
+        }
+    };
+
+    stream->chunk(length);
+    stream->depth(depth);
+
+    stream->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+    stream->on<uvw::file_drain_event>([&produce](const auto &, auto &hndl) { produce(hndl); });
+
+    ASSERT_TRUE(req->open_sync(filename, flags, mode_0644));
+    ASSERT_EQ(0, stream->start(*req));
+
+    std::cout << "Chunks of " << (length >> 10u) << " KiB, depth " << depth << ": ";
+
+    timer timer;
+    produce(*stream);
+    loop->run();
+    timer.elapsed(megabytes, "MiB");
+
+    ASSERT_EQ(written, total);
+    ASSERT_TRUE(req->close_sync());
+}
+
+void file_read(std::size_t length, std::size_t depth) {
+    auto loop = uvw::loop::get_default();
+    auto req = loop->resource<uvw::file_req>();
+    auto stream = loop->resource<uvw::file_read_stream>();
+    std::size_t read{};
+
+    stream->chunk(length);
+    stream->depth(depth);
+
+    stream->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+    stream->on<uvw::file_chunk_event>([&read](const uvw::file_chunk_event &event, auto &) { read += event.length; });
+
+    ASSERT_TRUE(req->open_sync(filename, uvw::file_req::file_open_flags::RDONLY, 0));
+    ASSERT_EQ(0, stream->start(*req));
+
+    std::cout << "Chunks of " << (length >> 10u) << " KiB, depth " << depth << ": ";
+
+    timer timer;
+    loop->run();
+    timer.elapsed(megabytes, "MiB");
+
+    ASSERT_EQ(read, megabytes << 20u);
+    ASSERT_TRUE(req->close_sync());
+}
+
+TEST(Benchmark, FileWriteStream) {
+    std::cout << "Writing " << megabytes << " MiB with a file write stream, a depth of 1 is a single request at a time" << std::endl;
+
+    for(auto length: lengths) {
+        for(auto depth: depths) {
+            file_write(length, depth);
+        }
+    }
+
+    uvw::loop::get_default()->resource<uvw::fs_req>()->unlink_sync(filename);
+}
+
+TEST(Benchmark, FileReadStream) {
+    std::cout << "Reading " << megabytes << " MiB with a file read stream, a depth of 1 is a single request at a time" << std::endl;
+
+    // the file is written once, reads hit the page cache unless it's dropped in between
+    file_write(uvw::file_write_stream::DEFAULT_CHUNK, 4u);
+
+    for(auto length: lengths) {
+        for(auto depth: depths) {
+            file_read(length, depth);
+        }
+    }
+
+    uvw::loop::get_default()->resource<uvw::fs_req>()->unlink_sync(filename);
+}
@@ -0,0 +1,89 @@
+#include <memory>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <uvw/channel.hpp>
+
+TEST(Channel, Functionalities) {
+    auto loop = uvw::loop::get_default();
+    auto handle = loop->resource<uvw::channel<int>>();
+
+    std::vector<int> received{};
+    bool checkCloseEvent = false;
+
+    handle->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    handle->on<uvw::channel_event<int>>([&received](const uvw::channel_event<int> &event, uvw::channel<int> &hndl) {
+        received.push_back(event.data);
+
+        if(received.size() == 3u) {
+            ASSERT_FALSE(hndl.closing());
+            hndl.close();
+            ASSERT_TRUE(hndl.closing());
+        }
+    });
+
+    handle->on<uvw::close_event>([&checkCloseEvent](const auto &, auto &) {
+        ASSERT_FALSE(checkCloseEvent);
+        checkCloseEvent = true;
+    });
+
+    ASSERT_EQ(&handle->parent(), loop.get());
+    ASSERT_EQ(0, handle->send(1));
+    ASSERT_EQ(0, handle->send(2));
+    ASSERT_EQ(0, handle->send(3));
+
+    handle.reset();
+    loop->run();
+
+    ASSERT_EQ(received, (std::vector<int>{1, 2, 3}));
+    ASSERT_TRUE(checkCloseEvent);
+}
+
+TEST(Channel, MultipleProducers) {
+    constexpr int producers = 4;
+    constexpr int values = 5000;
+
+    auto loop = uvw::loop::get_default();
+    auto handle = loop->resource<uvw::channel<std::unique_ptr<int>>>();
+
+    std::vector<int> last(producers, -1);
+    int count{};
+
+    handle->on<uvw::channel_event<std::unique_ptr<int>>>([&](uvw::channel_event<std::unique_ptr<int>> &event, auto &hndl) {
+        if(!event.data) {
+            // all the producers are done, nothing is sent once the channel is closed
+            hndl.close();
+        } else {
+            const int producer = *event.data / values;
+            const int value = *event.data % values;
+
+            ASSERT_EQ(last[producer] + 1, value);
+            last[producer] = value;
+            ++count;
+        }
+    });
+
+    std::thread sentinel{[handle]() {
+        std::vector<std::thread> threads{};
+
+        for(int producer{}; producer < producers; ++producer) {
+            threads.emplace_back([handle, producer]() {
+                for(int value{}; value < values; ++value) {
+                    ASSERT_EQ(0, handle->send(std::make_unique<int>(producer * values + value)));
+                }
+            });
+        }
+
+        for(auto &&thread: threads) {
+            thread.join();
+        }
+
+        ASSERT_EQ(0, handle->send(nullptr));
+    }};
+
+    loop->run();
+    sentinel.join();
+
+    ASSERT_EQ(count, producers * values);
+}
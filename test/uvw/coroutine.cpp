@@ -0,0 +1,172 @@
+#include <memory>
+#include <string>
+#include <gtest/gtest.h>
+#include <uvw/coroutine.hpp>
+#include <uvw/fs.h>
+#include <uvw/tcp.h>
+#include <uvw/work.h>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+namespace {
+
+uvw::detached_task queue(std::shared_ptr<uvw::work_req> req, int &steps) {
+    auto res = co_await uvw::awaitable<uvw::work_event>(*req, [](auto &work) { return work.queue(); });
+
+    EXPECT_TRUE(res);
+    EXPECT_FALSE(res.error());
+    EXPECT_EQ(steps, 1);
+    ++steps;
+}
+
+uvw::detached_task stat(std::shared_ptr<uvw::fs_req> req, std::string path, int &errors) {
+    auto res = co_await uvw::awaitable<uvw::fs_event>(*req, [&path](auto &fs) { fs.stat(path); });
+
+    EXPECT_FALSE(res);
+    EXPECT_EQ(res.error().code(), UV_ENOENT);
+    EXPECT_FALSE(req->has<uvw::error_event>());
+    ++errors;
+}
+
+uvw::detached_task connect(std::shared_ptr<uvw::tcp_handle> client, std::string address, unsigned int port, int &steps) {
+    if(auto res = co_await uvw::awaitable<uvw::connect_event>(*client, [&](auto &hndl) { return hndl.connect(address, port); }); res) {
+        ++steps;
+    }
+
+    if(auto res = co_await uvw::awaitable<uvw::write_event>(*client, [](auto &hndl) { return hndl.write(std::unique_ptr<char[]>(new char[2]{'a', 'b'}), 2u); }); res) {
+        ++steps;
+    }
+
+    client->close();
+}
+
+uvw::detached_task write(std::shared_ptr<uvw::tcp_handle> hndl, int &errors) {
+    // operations that fail immediately don't suspend the coroutine
+    auto res = co_await uvw::awaitable<uvw::write_event>(*hndl, [](auto &curr) { return curr.write(std::unique_ptr<char[]>(new char[1]{'a'}), 1u); });
+
+    EXPECT_FALSE(res);
+    EXPECT_TRUE(res.error());
+    ++errors;
+}
+
+uvw::detached_task close(std::shared_ptr<uvw::tcp_handle> hndl, int &errors) {
+    // the operation is started elsewhere, the coroutine only waits for it
+    auto res = co_await uvw::awaitable<uvw::close_event>(*hndl, [](auto &) {});
+
+    EXPECT_FALSE(res);
+    EXPECT_EQ(res.error().code(), UV_ECONNREFUSED);
+    ++errors;
+}
+
+uvw::detached_task refuse(std::shared_ptr<uvw::tcp_handle> hndl, std::string address, unsigned int port, int &errors) {
+    auto res = co_await uvw::awaitable<uvw::connect_event>(*hndl, [&](auto &curr) { return curr.connect(address, port); });
+
+    EXPECT_FALSE(res);
+    EXPECT_EQ(res.error().code(), UV_ECONNREFUSED);
+    ++errors;
+}
+
+} // namespace
+
+TEST(Coroutine, Work) {
+    auto loop = uvw::loop::get_default();
+    int steps{};
+
+    auto req = loop->resource<uvw::work_req>([&steps]() { ++steps; });
+    queue(req, steps);
+
+    // the work runs on the threadpool, the coroutine waits for its completion
+    ASSERT_TRUE(req->has<uvw::work_event>());
+
+    loop->run();
+
+    ASSERT_EQ(steps, 2);
+}
+
+TEST(Coroutine, Fs) {
+    auto loop = uvw::loop::get_default();
+    auto req = loop->resource<uvw::fs_req>();
+    int errors{};
+
+    stat(req, "test.file.missing", errors);
+
+    ASSERT_EQ(errors, 0);
+
+    loop->run();
+
+    ASSERT_EQ(errors, 1);
+}
+
+TEST(Coroutine, Stream) {
+    const std::string address = std::string{"127.0.0.1"};
+    const unsigned int port = 4242;
+
+    auto loop = uvw::loop::get_default();
+    auto server = loop->resource<uvw::tcp_handle>();
+    auto client = loop->resource<uvw::tcp_handle>();
+    auto other = loop->resource<uvw::tcp_handle>();
+    int steps{};
+    int errors{};
+
+    server->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    server->on<uvw::listen_event>([](const uvw::listen_event &, uvw::tcp_handle &handle) {
+        const std::shared_ptr<uvw::tcp_handle> socket = handle.parent().resource<uvw::tcp_handle>();
+
+        socket->on<uvw::error_event>([](const uvw::error_event &, uvw::tcp_handle &) { FAIL(); });
+        socket->on<uvw::close_event>([&handle](const uvw::close_event &, uvw::tcp_handle &) { handle.close(); });
+        socket->on<uvw::end_event>([](const uvw::end_event &, uvw::tcp_handle &sock) { sock.close(); });
+
+        ASSERT_EQ(0, handle.accept(*socket));
+        ASSERT_EQ(0, socket->read());
+    });
+
+    ASSERT_EQ(0, (server->bind(address, port)));
+    ASSERT_EQ(0, server->listen());
+
+    connect(client, address, port, steps);
+    write(other, errors);
+
+    ASSERT_EQ(errors, 1);
+    ASSERT_FALSE(other->has<uvw::write_event>());
+
+    other->close();
+    loop->run();
+
+    ASSERT_EQ(steps, 2);
+}
+
+TEST(Coroutine, Errors) {
+    const std::string address = std::string{"127.0.0.1"};
+    const unsigned int port = 4242;
+
+    auto loop = uvw::loop::get_default();
+    auto hndl = loop->resource<uvw::tcp_handle>();
+    bool checkCloseEvent = false;
+    int errors{};
+
+    hndl->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+    hndl->on<uvw::close_event>([&checkCloseEvent](const auto &, auto &) { checkCloseEvent = true; });
+
+    // error events reach all the coroutines waiting on the same emitter
+    close(hndl, errors);
+    refuse(hndl, address, port, errors);
+
+    ASSERT_EQ(errors, 0);
+    ASSERT_TRUE(hndl->has<uvw::connect_event>());
+
+    loop->run();
+
+    // listeners set aside while waiting are put back
+    ASSERT_EQ(errors, 2);
+    ASSERT_FALSE(hndl->has<uvw::connect_event>());
+    ASSERT_TRUE(hndl->has<uvw::close_event>());
+    ASSERT_TRUE(hndl->has<uvw::error_event>());
+
+    hndl->close();
+    loop->run();
+
+    ASSERT_TRUE(checkCloseEvent);
+}
+
+#endif
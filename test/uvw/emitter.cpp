@@ -61,3 +61,39 @@ TEST(Emitter, Functionalities) {
     ASSERT_FALSE(emitter.has<uvw::error_event>());
     ASSERT_FALSE(emitter.has<FakeEvent>());
 }
+
+struct StaticTestEmitter: uvw::emitter<StaticTestEmitter, FakeEvent> {
+    template<typename Handler>
+    void emit() {
+        dispatch<Handler>(FakeEvent{});
+        dispatch<Handler>(uvw::error_event{0});
+    }
+};
+
+struct StaticHandler {
+    static void on(FakeEvent &, StaticTestEmitter &) {
+        ++count;
+    }
+
+    static inline int count{};
+};
+
+TEST(Emitter, StaticHandler) {
+    StaticTestEmitter emitter{};
+    bool fake = false;
+    bool error = false;
+
+    emitter.on<FakeEvent>([&fake](const auto &, auto &) { fake = true; });
+    emitter.on<uvw::error_event>([&error](const auto &, auto &) { error = true; });
+
+    emitter.emit<StaticHandler>();
+
+    ASSERT_EQ(StaticHandler::count, 1);
+    ASSERT_FALSE(fake);
+    ASSERT_TRUE(error);
+
+    emitter.emit<void>();
+
+    ASSERT_EQ(StaticHandler::count, 1);
+    ASSERT_TRUE(fake);
+}
@@ -1,4 +1,10 @@
+#include <array>
 #include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 #include <gtest/gtest.h>
 #include <uvw/fs.h>
 
@@ -197,6 +203,145 @@ TEST(FileReq, RWSync) {
     loop->run();
 }
 
+TEST(FileReq, RWVectored) {
+    static constexpr auto mode_0644 = 0644;
+    const std::string filename = std::string{TARGET_FILE_REQ_DIR} + std::string{"/test.file"};
+    char header[2]{};
+    char payload[3]{};
+
+    auto loop = uvw::loop::get_default();
+    auto request = loop->resource<uvw::file_req>();
+
+    bool checkFileWriteEvent = false;
+    bool checkFileReadEvent = false;
+
+    request->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    request->on<uvw::fs_event>([&](const auto &event, auto &req) {
+        if(event.type == uvw::fs_req::fs_type::OPEN) {
+            std::vector<std::pair<std::unique_ptr<char[]>, unsigned int>> data{};
+            data.emplace_back(std::unique_ptr<char[]>{new char[2]{'a', 'b'}}, 2u);
+            data.emplace_back(std::unique_ptr<char[]>{new char[3]{'c', 'd', 'e'}}, 3u);
+            req.write(std::move(data), 0);
+        } else if(event.type == uvw::fs_req::fs_type::READ) {
+            ASSERT_FALSE(checkFileReadEvent);
+            ASSERT_EQ(event.result, 5u);
+            ASSERT_EQ(event.read.data, nullptr);
+            ASSERT_EQ(std::string(header, 2u), "ab");
+            ASSERT_EQ(std::string(payload, 3u), "cde");
+            checkFileReadEvent = true;
+            req.close();
+        } else if(event.type == uvw::fs_req::fs_type::WRITE) {
+            ASSERT_FALSE(checkFileWriteEvent);
+            ASSERT_EQ(event.result, 5u);
+            checkFileWriteEvent = true;
+            std::array bufs{uv_buf_init(header, 2u), uv_buf_init(payload, 3u)};
+            req.read(bufs.data(), static_cast<unsigned int>(bufs.size()), 0);
+        };
+    });
+
+    auto flags = uvw::file_req::file_open_flags::CREAT | uvw::file_req::file_open_flags::RDWR | uvw::file_req::file_open_flags::TRUNC;
+    request->open(filename, flags, mode_0644);
+
+    loop->run();
+
+    ASSERT_TRUE(checkFileWriteEvent);
+    ASSERT_TRUE(checkFileReadEvent);
+}
+
+TEST(FileReq, RWVectoredSync) {
+    static constexpr auto mode_0644 = 0644;
+    const std::string filename = std::string{TARGET_FILE_REQ_DIR} + std::string{"/test.file"};
+    char header[]{'a', 'b'};
+    char payload[]{'c', 'd', 'e'};
+
+    auto loop = uvw::loop::get_default();
+    auto request = loop->resource<uvw::file_req>();
+    auto flags = uvw::file_req::file_open_flags::CREAT | uvw::file_req::file_open_flags::RDWR | uvw::file_req::file_open_flags::TRUNC;
+
+    ASSERT_TRUE(request->open_sync(filename, flags, mode_0644));
+
+    std::array bufs{uv_buf_init(header, 2u), uv_buf_init(payload, 3u)};
+    auto writeR = request->write_sync(bufs.data(), static_cast<unsigned int>(bufs.size()), 0);
+
+    ASSERT_TRUE(writeR.first);
+    ASSERT_EQ(writeR.second, std::size_t{5});
+
+    std::vector<std::pair<std::unique_ptr<char[]>, unsigned int>> data{};
+    data.emplace_back(std::unique_ptr<char[]>{new char[1]{'f'}}, 1u);
+    writeR = request->write_sync(std::move(data), 5);
+
+    ASSERT_TRUE(writeR.first);
+    ASSERT_EQ(writeR.second, std::size_t{1});
+
+    char first[4]{};
+    char second[2]{};
+    std::array views{uv_buf_init(first, 4u), uv_buf_init(second, 2u)};
+    auto readR = request->read_sync(views.data(), static_cast<unsigned int>(views.size()), 0);
+
+    ASSERT_TRUE(readR.first);
+    ASSERT_EQ(readR.second, std::size_t{6});
+    ASSERT_EQ(std::string(first, 4u), "abcd");
+    ASSERT_EQ(std::string(second, 2u), "ef");
+    ASSERT_TRUE(request->close_sync());
+
+    loop->run();
+}
+
+TEST(FileReq, RWIntoBuffer) {
+    static constexpr auto mode_0644 = 0644;
+    const std::string filename = std::string{TARGET_FILE_REQ_DIR} + std::string{"/test.file"};
+    auto buf = uvw::file_req::make_aligned(uvw::file_req::DIRECT_ALIGNMENT);
+
+    ASSERT_NE(buf, nullptr);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(buf.get()) % uvw::file_req::DIRECT_ALIGNMENT, 0u);
+    ASSERT_EQ(uvw::file_req::make_aligned(1u, 3u), nullptr);
+
+    auto loop = uvw::loop::get_default();
+    auto request = loop->resource<uvw::file_req>();
+
+    int reads{};
+
+    request->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    request->on<uvw::fs_event>([&](const auto &event, auto &req) {
+        if(event.type == uvw::fs_req::fs_type::OPEN) {
+            req.write(std::unique_ptr<char[]>{new char[2]{'a', 'b'}}, 2, 0);
+        } else if(event.type == uvw::fs_req::fs_type::WRITE) {
+            req.read(buf.get(), 1u, 0);
+        } else if(event.type == uvw::fs_req::fs_type::READ) {
+            ASSERT_EQ(event.result, 1u);
+            ASSERT_EQ(event.read.data, nullptr);
+
+            // the same buffer is reused by all the reads
+            if(reads++ == 0) {
+                ASSERT_EQ(buf[0], 'a');
+                req.read(buf.get(), 1u, 1);
+            } else {
+                ASSERT_EQ(buf[0], 'b');
+                req.close();
+            }
+        };
+    });
+
+    auto flags = uvw::file_req::file_open_flags::CREAT | uvw::file_req::file_open_flags::RDWR | uvw::file_req::file_open_flags::TRUNC;
+    request->open(filename, flags, mode_0644);
+
+    loop->run();
+
+    ASSERT_EQ(reads, 2);
+    ASSERT_TRUE(request->open_sync(filename, uvw::file_req::file_open_flags::RDONLY, mode_0644));
+
+    auto readR = request->read_sync(buf.get(), 4u, 0);
+
+    ASSERT_TRUE(readR.first);
+    ASSERT_EQ(readR.second, std::size_t{2});
+    ASSERT_EQ(std::string(buf.get(), 2u), "ab");
+    ASSERT_TRUE(request->close_sync());
+
+    loop->run();
+}
+
 TEST(FileReq, Stat) {
     static constexpr auto mode_0644 = 0644;
     const std::string filename = std::string{TARGET_FILE_REQ_DIR} + std::string{"/test.file"};
@@ -1,5 +1,12 @@
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
 #include <gtest/gtest.h>
 #include <uvw/fs.h>
+#include <uvw/pipe.h>
+#include <uvw/tcp.h>
+#include <uvw/timer.h>
 
 #ifdef _WIN32
 // NOLINTNEXTLINE(bugprone-reserved-identifier,cppcoreguidelines-macro-usage)
@@ -7,6 +14,30 @@
 #    include <fcntl.h>
 #endif
 
+namespace {
+
+std::vector<char> populate(const std::string &filename, std::size_t size) {
+    static constexpr auto mode_0644 = 0644;
+    auto loop = uvw::loop::get_default();
+    auto req = loop->resource<uvw::file_req>();
+    std::vector<char> data(size);
+
+    for(std::size_t pos{}; pos < size; ++pos) {
+        data[pos] = static_cast<char>(pos % 251u);
+    }
+
+    auto flags = uvw::file_req::file_open_flags::CREAT | uvw::file_req::file_open_flags::WRONLY | uvw::file_req::file_open_flags::TRUNC;
+
+    EXPECT_TRUE(req->open_sync(filename, flags, mode_0644));
+    const uv_buf_t buf = uv_buf_init(data.data(), static_cast<unsigned int>(size));
+    EXPECT_EQ(req->write_sync(&buf, 1u, 0).second, size);
+    EXPECT_TRUE(req->close_sync());
+
+    return data;
+}
+
+} // namespace
+
 TEST(FileReq, SendFile) {
     static constexpr auto mode_0644 = 0644;
 
@@ -68,3 +99,192 @@ TEST(FileReq, SendFileSync) {
 
     loop->run();
 }
+
+TEST(StreamHandle, SendFile) {
+    const std::string filename = std::string{TARGET_FILE_REQ_SENDFILE_DIR} + std::string{"/src.file"};
+    const std::string address = std::string{"127.0.0.1"};
+    const unsigned int port = 4242;
+    const std::size_t offset = 100u;
+
+    const auto data = populate(filename, (3u << 20u) + 123u);
+
+    auto loop = uvw::loop::get_default();
+    auto file = loop->resource<uvw::file_req>();
+    auto server = loop->resource<uvw::tcp_handle>();
+    auto client = loop->resource<uvw::tcp_handle>();
+
+    std::string received{};
+    std::size_t progress{};
+    bool checkSendFileEvent = false;
+
+    server->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+    client->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    server->on<uvw::listen_event>([&](const uvw::listen_event &, uvw::tcp_handle &handle) {
+        auto socket = handle.parent().resource<uvw::tcp_handle>();
+
+        socket->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+        socket->on<uvw::send_file_progress_event>([&](const uvw::send_file_progress_event &event, uvw::tcp_handle &) {
+            ASSERT_GT(event.sent, progress);
+            ASSERT_EQ(event.length, data.size() - offset);
+            progress = event.sent;
+        });
+
+        socket->on<uvw::send_file_event>([&](const uvw::send_file_event &event, uvw::tcp_handle &sock) {
+            ASSERT_FALSE(checkSendFileEvent);
+            ASSERT_EQ(event.sent, data.size() - offset);
+            checkSendFileEvent = true;
+            sock.close();
+            handle.close();
+        });
+
+        ASSERT_EQ(0, handle.accept(*socket));
+
+        // a small buffer fills up soon, the transfer has to wait for the socket to be writable
+        ASSERT_EQ(0, socket->send_buffer_size(4096));
+
+        // data queued before the transfer are sent first
+        ASSERT_EQ(0, socket->write(std::unique_ptr<char[]>{new char[1]{'*'}}, 1u));
+        ASSERT_EQ(0, socket->send_file(*file, static_cast<int64_t>(offset), data.size() - offset));
+    });
+
+    client->on<uvw::data_event>([&received](const uvw::data_event &event, uvw::tcp_handle &) {
+        received.append(event.data.get(), event.length);
+    });
+
+    client->on<uvw::end_event>([](const uvw::end_event &, uvw::tcp_handle &handle) {
+        handle.close();
+    });
+
+    client->on<uvw::connect_event>([](const uvw::connect_event &, uvw::tcp_handle &handle) {
+        ASSERT_EQ(0, handle.read());
+    });
+
+    ASSERT_TRUE(file->open_sync(filename, uvw::file_req::file_open_flags::RDONLY, 0));
+
+    server->bind(address, port);
+    server->listen();
+    ASSERT_EQ(0, client->bind(address, 0u));
+    ASSERT_EQ(0, client->recv_buffer_size(4096));
+    client->connect(address, port);
+
+    loop->run();
+
+    ASSERT_TRUE(checkSendFileEvent);
+    ASSERT_EQ(progress, data.size() - offset);
+    ASSERT_EQ(received.size(), data.size() - offset + 1u);
+    ASSERT_EQ(received.front(), '*');
+    ASSERT_EQ(received.compare(1u, std::string::npos, data.data() + offset, data.size() - offset), 0);
+    ASSERT_TRUE(file->close_sync());
+}
+
+TEST(StreamHandle, SendFilePath) {
+    const std::string filename = std::string{TARGET_FILE_REQ_SENDFILE_DIR} + std::string{"/src.file"};
+    const auto data = populate(filename, (1u << 17u) + 123u);
+
+    auto loop = uvw::loop::get_default();
+    auto reader = loop->resource<uvw::pipe_handle>();
+    auto writer = loop->resource<uvw::pipe_handle>();
+
+    std::string received{};
+    bool checkSendFileEvent = false;
+    bool checkErrorEvent = false;
+    uv_file fds[2];
+
+    ASSERT_EQ(0, uv_pipe(fds, 0, 0));
+    ASSERT_EQ(0, reader->open(uvw::file_handle{fds[0]}));
+    ASSERT_EQ(0, writer->open(uvw::file_handle{fds[1]}));
+
+    writer->on<uvw::error_event>([&checkErrorEvent](const uvw::error_event &, uvw::pipe_handle &) {
+        ASSERT_FALSE(checkErrorEvent);
+        checkErrorEvent = true;
+    });
+
+    writer->on<uvw::send_file_event>([&](const uvw::send_file_event &event, uvw::pipe_handle &handle) {
+        ASSERT_FALSE(checkSendFileEvent);
+        // the transfer ends early when the end of the file is reached
+        ASSERT_EQ(event.sent, data.size());
+        checkSendFileEvent = true;
+        handle.close();
+    });
+
+    reader->on<uvw::data_event>([&received](const uvw::data_event &event, uvw::pipe_handle &) {
+        received.append(event.data.get(), event.length);
+    });
+
+    reader->on<uvw::end_event>([](const uvw::end_event &, uvw::pipe_handle &handle) {
+        handle.close();
+    });
+
+    ASSERT_EQ(0, reader->read());
+    ASSERT_EQ(0, writer->send_file(filename + ".none", 0, 1u));
+    ASSERT_EQ(0, writer->send_file(filename, 0, data.size() + 1000u));
+    ASSERT_EQ(UV_EINVAL, writer->send_file(filename, 0, 0u));
+
+    loop->run();
+
+    ASSERT_TRUE(checkErrorEvent);
+    ASSERT_TRUE(checkSendFileEvent);
+    ASSERT_EQ(received, std::string(data.data(), data.size()));
+}
+
+TEST(StreamHandle, SendFileClose) {
+    const std::string filename = std::string{TARGET_FILE_REQ_SENDFILE_DIR} + std::string{"/src.file"};
+    const std::string address = std::string{"127.0.0.1"};
+    const unsigned int port = 4242;
+
+    const auto data = populate(filename, 8u << 20u);
+
+    auto loop = uvw::loop::get_default();
+    auto server = loop->resource<uvw::tcp_handle>();
+    auto client = loop->resource<uvw::tcp_handle>();
+    auto timer = loop->resource<uvw::timer_handle>();
+
+    bool checkErrorEvent = false;
+    bool checkCloseEvent = false;
+
+    server->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+    client->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    server->on<uvw::listen_event>([&](const uvw::listen_event &, uvw::tcp_handle &handle) {
+        auto socket = handle.parent().resource<uvw::tcp_handle>();
+
+        socket->on<uvw::send_file_event>([](const auto &, auto &) { FAIL(); });
+
+        socket->on<uvw::error_event>([&checkErrorEvent](const uvw::error_event &event, uvw::tcp_handle &) {
+            ASSERT_FALSE(checkErrorEvent);
+            ASSERT_EQ(event.code(), UV_ECANCELED);
+            checkErrorEvent = true;
+        });
+
+        socket->on<uvw::close_event>([&](const uvw::close_event &, uvw::tcp_handle &) {
+            checkCloseEvent = true;
+            client->close();
+            handle.close();
+        });
+
+        ASSERT_EQ(0, handle.accept(*socket));
+        ASSERT_EQ(0, socket->send_buffer_size(4096));
+        ASSERT_EQ(0, socket->send_file(filename, 0, data.size()));
+
+        // the peer never reads, the transfer is stuck when the stream is closed
+        timer->on<uvw::timer_event>([socket](const uvw::timer_event &, uvw::timer_handle &hndl) {
+            socket->close();
+            hndl.close();
+        });
+
+        ASSERT_EQ(0, timer->start(uvw::timer_handle::time{50}, uvw::timer_handle::time{0}));
+    });
+
+    server->bind(address, port);
+    server->listen();
+    ASSERT_EQ(0, client->bind(address, 0u));
+    ASSERT_EQ(0, client->recv_buffer_size(4096));
+    client->connect(address, port);
+
+    loop->run();
+
+    ASSERT_TRUE(checkErrorEvent);
+    ASSERT_TRUE(checkCloseEvent);
+}
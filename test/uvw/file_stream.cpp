@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <uvw/file_stream.h>
+#include <uvw/fs.h>
+#include <uvw/timer.h>
+
+namespace {
+
+const std::string filename = std::string{TARGET_FILE_STREAM_DIR} + std::string{"/test.file"};
+
+std::vector<char> content(std::size_t size) {
+    std::vector<char> data(size);
+
+    for(std::size_t pos{}; pos < size; ++pos) {
+        data[pos] = static_cast<char>(pos % 251u);
+    }
+
+    return data;
+}
+
+void populate(uvw::loop &loop, const std::vector<char> &data) {
+    static constexpr auto mode_0644 = 0644;
+    auto req = loop.resource<uvw::file_req>();
+    auto stream = loop.resource<uvw::file_write_stream>();
+    auto flags = uvw::file_req::file_open_flags::CREAT | uvw::file_req::file_open_flags::WRONLY | uvw::file_req::file_open_flags::TRUNC;
+
+    bool checkFileEndEvent = false;
+    std::size_t drains{};
+
+    stream->chunk(4096u);
+    stream->depth(2u);
+    stream->sync_every(8192u);
+
+    stream->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    stream->on<uvw::file_drain_event>([&](const auto &, auto &hndl) {
+        ASSERT_EQ(drains++, 0u);
+        ASSERT_EQ(hndl.queued(), 0u);
+
+        // data that don't fill a chunk are written on end
+        hndl.end();
+
+        ASSERT_EQ(UV_EINVAL, hndl.write(data.data(), 1u));
+    });
+
+    stream->on<uvw::file_end_event>([&checkFileEndEvent](const auto &, auto &hndl) {
+        ASSERT_FALSE(checkFileEndEvent);
+        ASSERT_FALSE(hndl.active());
+        ASSERT_EQ(hndl.queued(), 0u);
+        checkFileEndEvent = true;
+    });
+
+    ASSERT_TRUE(req->open_sync(filename, flags, mode_0644));
+    ASSERT_EQ(UV_EINVAL, stream->write(data.data(), data.size()));
+    ASSERT_EQ(0, stream->start(*req));
+    ASSERT_EQ(UV_EBUSY, stream->start(*req));
+
+    // small writes are coalesced into chunks
+    for(std::size_t pos{}; pos < data.size(); pos += 100u) {
+        ASSERT_EQ(0, stream->write(data.data() + pos, std::min<std::size_t>(100u, data.size() - pos)));
+    }
+
+    ASSERT_NE(stream->queued(), 0u);
+
+    loop.run();
+
+    ASSERT_TRUE(checkFileEndEvent);
+    ASSERT_EQ(drains, 1u);
+    ASSERT_TRUE(req->close_sync());
+}
+
+} // namespace
+
+TEST(FileStream, WriteAndRead) {
+    auto loop = uvw::loop::get_default();
+    auto req = loop->resource<uvw::file_req>();
+    auto stream = loop->resource<uvw::file_read_stream>();
+    auto timer = loop->resource<uvw::timer_handle>();
+    const auto data = content(100003u);
+
+    populate(*loop, data);
+
+    std::vector<char> result{};
+    bool checkFileEndEvent = false;
+
+    stream->chunk(4096u);
+    stream->depth(3u);
+
+    stream->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    stream->on<uvw::file_chunk_event>([&](const uvw::file_chunk_event &event, uvw::file_read_stream &hndl) {
+        ASSERT_EQ(event.offset, static_cast<int64_t>(result.size()));
+        ASSERT_LE(event.length, 4096u);
+        result.insert(result.end(), event.data.get(), event.data.get() + event.length);
+
+        if(event.offset == 0) {
+            // backpressure, nothing is emitted until resumed
+            hndl.pause();
+
+            timer->on<uvw::timer_event>([&hndl](const auto &, auto &handle) {
+                hndl.resume();
+                handle.close();
+            });
+
+            timer->start(uvw::timer_handle::time{10}, uvw::timer_handle::time{0});
+        }
+    });
+
+    stream->on<uvw::file_end_event>([&](const auto &, auto &hndl) {
+        ASSERT_FALSE(checkFileEndEvent);
+        ASSERT_FALSE(hndl.active());
+        checkFileEndEvent = true;
+    });
+
+    ASSERT_TRUE(req->open_sync(filename, uvw::file_req::file_open_flags::RDONLY, 0));
+    ASSERT_EQ(0, stream->start(*req));
+    ASSERT_TRUE(stream->active());
+    ASSERT_EQ(UV_EBUSY, stream->start(*req));
+
+    stream.reset();
+    loop->run();
+
+    ASSERT_TRUE(checkFileEndEvent);
+    ASSERT_EQ(result, data);
+    ASSERT_TRUE(req->close_sync());
+}
+
+TEST(FileStream, Stop) {
+    auto loop = uvw::loop::get_default();
+    auto req = loop->resource<uvw::file_req>();
+    auto stream = loop->resource<uvw::file_read_stream>();
+
+    populate(*loop, content(8192u));
+
+    std::size_t chunks{};
+    bool checkFileEndEvent = false;
+
+    stream->chunk(1024u);
+
+    stream->on<uvw::file_chunk_event>([&chunks](const uvw::file_chunk_event &event, uvw::file_read_stream &hndl) {
+        ASSERT_EQ(event.offset, 1024);
+        ++chunks;
+        hndl.stop();
+    });
+
+    stream->on<uvw::file_end_event>([&checkFileEndEvent](const auto &, auto &) {
+        ASSERT_FALSE(checkFileEndEvent);
+        checkFileEndEvent = true;
+    });
+
+    ASSERT_TRUE(req->open_sync(filename, uvw::file_req::file_open_flags::RDONLY, 0));
+    ASSERT_EQ(0, stream->start(*req, 1024));
+    loop->run();
+
+    ASSERT_EQ(chunks, 1u);
+    ASSERT_TRUE(checkFileEndEvent);
+    ASSERT_TRUE(req->close_sync());
+}
+
+TEST(FileStream, Error) {
+    auto loop = uvw::loop::get_default();
+    auto reader = loop->resource<uvw::file_read_stream>();
+    auto writer = loop->resource<uvw::file_write_stream>();
+    const auto data = content(1024u);
+
+    int errors{};
+    int ends{};
+
+    reader->on<uvw::file_chunk_event>([](const auto &, auto &) { FAIL(); });
+    reader->on<uvw::error_event>([&errors](const auto &, auto &) { ++errors; });
+    reader->on<uvw::file_end_event>([&ends](const auto &, auto &) { ++ends; });
+
+    writer->on<uvw::file_drain_event>([](const auto &, auto &) { FAIL(); });
+    writer->on<uvw::error_event>([&errors](const auto &, auto &) { ++errors; });
+    writer->on<uvw::file_end_event>([&ends](const auto &, auto &) { ++ends; });
+
+    writer->chunk(data.size());
+
+    ASSERT_EQ(0, reader->start(uvw::file_handle{-1}));
+    ASSERT_EQ(0, writer->start(uvw::file_handle{-1}));
+    ASSERT_EQ(0, writer->write(data.data(), data.size()));
+
+    loop->run();
+
+    ASSERT_EQ(errors, 2);
+    ASSERT_EQ(ends, 2);
+    ASSERT_FALSE(reader->active());
+    ASSERT_FALSE(writer->active());
+}
@@ -825,6 +825,77 @@ TEST(FsReq, ReadDir) {
     ASSERT_TRUE(checkFsOpenDirEvent);
 }
 
+TEST(FsReq, ReadDirBatch) {
+    const std::string dir_name = std::string{TARGET_FS_REQ_DIR} + std::string{"/batch"};
+    const std::size_t count = 5u;
+
+    auto loop = uvw::loop::get_default();
+    auto fsReq = loop->resource<uvw::fs_req>();
+
+    ASSERT_TRUE(fsReq->mkdir_sync(dir_name, 0755));
+
+    for(std::size_t pos{}; pos < count; ++pos) {
+        ASSERT_TRUE(fsReq->mkdir_sync(dir_name + "/" + std::to_string(pos), 0755));
+    }
+
+    std::size_t events{};
+    std::size_t entries{};
+    bool checkFsCloseDirEvent = false;
+
+    fsReq->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    fsReq->on<uvw::fs_event>([&](const auto &event, auto &req) {
+        if(event.type == uvw::fs_req::fs_type::CLOSEDIR) {
+            ASSERT_FALSE(checkFsCloseDirEvent);
+            checkFsCloseDirEvent = true;
+        } else if(event.type == uvw::fs_req::fs_type::OPENDIR) {
+            req.readdir(2u);
+        } else if(event.type == uvw::fs_req::fs_type::READDIR) {
+            ++events;
+            ASSERT_LE(event.entries.length, 2u);
+
+            for(std::size_t pos{}; pos < event.entries.length; ++pos) {
+                ASSERT_EQ(static_cast<uvw::fs_req::entry_type>(event.entries.data[pos].type), uvw::fs_req::entry_type::DIR);
+                ++entries;
+            }
+
+            if(event.entries.length) {
+                req.readdir(2u);
+            } else {
+                ASSERT_TRUE(event.dirent.eos);
+                req.closedir();
+            }
+        }
+    });
+
+    fsReq->opendir(dir_name);
+    loop->run();
+
+    ASSERT_TRUE(checkFsCloseDirEvent);
+    ASSERT_EQ(entries, count);
+    ASSERT_EQ(events, 4u);
+
+    ASSERT_TRUE(fsReq->opendir_sync(dir_name));
+
+    auto res = fsReq->readdir_sync(count + 1u);
+
+    ASSERT_TRUE(res.first);
+    ASSERT_EQ(res.second.second, count);
+
+    // mixing batch and single entry iterations is fine
+    ASSERT_FALSE(fsReq->readdir_sync().first);
+    ASSERT_FALSE(fsReq->readdir_sync(count).first);
+    ASSERT_TRUE(fsReq->closedir_sync());
+
+    for(std::size_t pos{}; pos < count; ++pos) {
+        ASSERT_TRUE(fsReq->rmdir_sync(dir_name + "/" + std::to_string(pos)));
+    }
+
+    ASSERT_TRUE(fsReq->rmdir_sync(dir_name));
+
+    loop->run();
+}
+
 TEST(FsReq, ReadDirSync) {
     const std::string dir_name = std::string{TARGET_FS_REQ_DIR};
 
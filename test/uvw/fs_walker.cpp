@@ -0,0 +1,204 @@
+#include <memory>
+#include <set>
+#include <string>
+#include <gtest/gtest.h>
+#include <uvw/fs.h>
+#include <uvw/fs_walker.h>
+#include <uvw/timer.h>
+
+namespace {
+
+const std::string root = std::string{TARGET_FS_WALKER_DIR} + std::string{"/tree"};
+
+void touch(uvw::loop &loop, const std::string &path) {
+    static constexpr auto mode_0644 = 0644;
+    auto req = loop.resource<uvw::file_req>();
+    auto flags = uvw::file_req::file_open_flags::CREAT | uvw::file_req::file_open_flags::WRONLY;
+
+    ASSERT_TRUE(req->open_sync(path, flags, mode_0644));
+    ASSERT_TRUE(req->close_sync());
+}
+
+// root/{d0/{d1/{f2}, f0, f1}, f3}
+void setup(uvw::loop &loop) {
+    static constexpr auto mode_0755 = 0755;
+    auto req = loop.resource<uvw::fs_req>();
+
+    ASSERT_TRUE(req->mkdir_sync(root, mode_0755));
+    ASSERT_TRUE(req->mkdir_sync(root + "/d0", mode_0755));
+    ASSERT_TRUE(req->mkdir_sync(root + "/d0/d1", mode_0755));
+
+    touch(loop, root + "/d0/f0");
+    touch(loop, root + "/d0/f1");
+    touch(loop, root + "/d0/d1/f2");
+    touch(loop, root + "/f3");
+}
+
+void teardown(uvw::loop &loop) {
+    auto req = loop.resource<uvw::fs_req>();
+
+    req->unlink_sync(root + "/d0/d1/loop");
+    req->unlink_sync(root + "/d0/d1/f2");
+    req->unlink_sync(root + "/d0/f1");
+    req->unlink_sync(root + "/d0/f0");
+    req->unlink_sync(root + "/f3");
+    req->rmdir_sync(root + "/d0/d1");
+    req->rmdir_sync(root + "/d0");
+    req->rmdir_sync(root);
+}
+
+} // namespace
+
+TEST(FsWalker, Walk) {
+    auto loop = uvw::loop::get_default();
+    auto walker = loop->resource<uvw::fs_walker>();
+    auto timer = loop->resource<uvw::timer_handle>();
+
+    teardown(*loop);
+    setup(*loop);
+
+    std::set<std::string> paths{};
+    std::size_t events{};
+    bool checkFsWalkEndEvent = false;
+
+    walker->batch(2u);
+    walker->concurrency(2u);
+    walker->stat(true);
+
+    walker->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    walker->on<uvw::fs_walk_event>([&](const uvw::fs_walk_event &event, uvw::fs_walker &hndl) {
+        ASSERT_LE(event.entries.size(), 2u);
+        ASSERT_FALSE(event.entries.empty());
+
+        for(auto &&entry: event.entries) {
+            ASSERT_EQ(entry.path.compare(0u, root.size(), root), 0);
+            ASSERT_EQ(entry.type == uvw::fs_req::entry_type::DIR, (entry.stat.st_mode & S_IFMT) == S_IFDIR);
+            ASSERT_TRUE(paths.insert(entry.path.substr(root.size())).second);
+        }
+
+        if(events++ == 0u) {
+            // backpressure, nothing is emitted until resumed
+            hndl.pause();
+
+            timer->on<uvw::timer_event>([&hndl](const auto &, auto &handle) {
+                hndl.resume();
+                handle.close();
+            });
+
+            timer->start(uvw::timer_handle::time{10}, uvw::timer_handle::time{0});
+        }
+    });
+
+    walker->on<uvw::fs_walk_end_event>([&](const auto &, auto &hndl) {
+        ASSERT_FALSE(checkFsWalkEndEvent);
+        ASSERT_FALSE(hndl.active());
+        checkFsWalkEndEvent = true;
+    });
+
+    ASSERT_EQ(0, walker->start(root));
+    ASSERT_TRUE(walker->active());
+    ASSERT_EQ(UV_EBUSY, walker->start(root));
+
+    walker.reset();
+    loop->run();
+
+    ASSERT_TRUE(checkFsWalkEndEvent);
+    ASSERT_EQ(paths, (std::set<std::string>{"/d0", "/d0/d1", "/d0/d1/f2", "/d0/f0", "/d0/f1", "/f3"}));
+    ASSERT_GE(events, 3u);
+
+    teardown(*loop);
+}
+
+TEST(FsWalker, Filter) {
+    auto loop = uvw::loop::get_default();
+    auto walker = loop->resource<uvw::fs_walker>();
+
+    teardown(*loop);
+    setup(*loop);
+
+    std::set<std::string> paths{};
+
+    walker->filter([](const uvw::fs_walk_entry &entry) {
+        return entry.path != root + "/d0/d1";
+    });
+
+    walker->on<uvw::fs_walk_event>([&](const uvw::fs_walk_event &event, auto &) {
+        for(auto &&entry: event.entries) {
+            ASSERT_EQ(entry.depth, (entry.path.find('/', root.size() + 1u) == std::string::npos) ? 0u : 1u);
+            paths.insert(entry.path.substr(root.size()));
+        }
+    });
+
+    ASSERT_EQ(0, walker->start(root + "/"));
+    loop->run();
+
+    ASSERT_EQ(paths, (std::set<std::string>{"/d0", "/d0/f0", "/d0/f1", "/f3"}));
+
+    teardown(*loop);
+}
+
+TEST(FsWalker, Error) {
+    auto loop = uvw::loop::get_default();
+    auto walker = loop->resource<uvw::fs_walker>();
+
+    bool checkErrorEvent = false;
+    bool checkFsWalkEndEvent = false;
+
+    walker->on<uvw::fs_walk_event>([](const auto &, auto &) { FAIL(); });
+
+    walker->on<uvw::error_event>([&](const auto &, auto &) {
+        ASSERT_FALSE(checkErrorEvent);
+        checkErrorEvent = true;
+    });
+
+    walker->on<uvw::fs_walk_end_event>([&](const auto &, auto &) {
+        ASSERT_FALSE(checkFsWalkEndEvent);
+        checkFsWalkEndEvent = true;
+    });
+
+    ASSERT_EQ(0, walker->start(root + "/none"));
+    loop->run();
+
+    ASSERT_TRUE(checkErrorEvent);
+    ASSERT_TRUE(checkFsWalkEndEvent);
+}
+
+#ifndef _WIN32
+TEST(FsWalker, Follow) {
+    auto loop = uvw::loop::get_default();
+    auto req = loop->resource<uvw::fs_req>();
+
+    teardown(*loop);
+    setup(*loop);
+
+    ASSERT_TRUE(req->symlink_sync("../..", root + "/d0/d1/loop"));
+
+    for(const bool follow: {false, true}) {
+        auto walker = loop->resource<uvw::fs_walker>();
+        std::size_t entries{};
+        uvw::fs_req::entry_type type{};
+
+        walker->follow(follow);
+
+        walker->on<uvw::fs_walk_event>([&](const uvw::fs_walk_event &event, auto &) {
+            for(auto &&entry: event.entries) {
+                if(entry.path == root + "/d0/d1/loop") {
+                    type = entry.type;
+                }
+
+                ++entries;
+            }
+        });
+
+        ASSERT_EQ(0, walker->start(root));
+        loop->run();
+
+        // cycles are detected, the target of the link is walked only once
+        ASSERT_EQ(entries, 7u);
+        ASSERT_EQ(type, follow ? uvw::fs_req::entry_type::DIR : uvw::fs_req::entry_type::LINK);
+    }
+
+    teardown(*loop);
+}
+#endif
@@ -0,0 +1,126 @@
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <gtest/gtest.h>
+#include <uvw/loop_group.h>
+#include <uvw/tcp.h>
+#include <uvw/timer.h>
+
+namespace {
+
+void connect(uvw::loop &loop, const std::string &address, unsigned int port, std::size_t count) {
+    for(std::size_t pos{}; pos < count; ++pos) {
+        auto client = loop.resource<uvw::tcp_handle>();
+
+        client->on<uvw::error_event>([](const uvw::error_event &, uvw::tcp_handle &) { FAIL(); });
+        client->on<uvw::connect_event>([](const uvw::connect_event &, uvw::tcp_handle &handle) { ASSERT_EQ(0, handle.read()); });
+        client->on<uvw::end_event>([](const uvw::end_event &, uvw::tcp_handle &handle) { handle.close(); });
+
+        ASSERT_EQ(0, client->connect(address, port));
+    }
+}
+
+} // namespace
+
+TEST(LoopGroup, Functionalities) {
+    uvw::loop_group group{2u};
+
+    ASSERT_EQ(group.size(), 2u);
+    ASSERT_NE(&group[0u], &group[1u]);
+
+    std::array<std::atomic_int, 2u> calls{};
+    std::atomic_int running{};
+
+    group.affinity(true);
+
+    ASSERT_EQ(0, group.run([&](uvw::loop &loop, std::size_t pos) {
+        ASSERT_EQ(&loop, &group[pos]);
+        ++calls[pos];
+
+        auto timer = loop.resource<uvw::timer_handle>();
+        timer->on<uvw::timer_event>([](const uvw::timer_event &, uvw::timer_handle &) { FAIL(); });
+        timer->start(uvw::timer_handle::time{10000}, uvw::timer_handle::time{0});
+
+        if(++running == 2) {
+            group.stop();
+        }
+    }));
+
+    ASSERT_EQ(UV_EBUSY, group.run());
+
+    group.join();
+
+    ASSERT_EQ(calls[0u], 1);
+    ASSERT_EQ(calls[1u], 1);
+    ASSERT_FALSE(group[0u].alive());
+    ASSERT_FALSE(group[1u].alive());
+
+    ASSERT_EQ(0, group.run());
+
+    group.stop();
+    group.stop();
+    group.join();
+}
+
+TEST(LoopGroup, ServeIPC) {
+    const std::string address = std::string{"127.0.0.1"};
+    const unsigned int port = 4242;
+
+    uvw::loop_group group{2u};
+    std::array<std::atomic_int, 2u> accepted{};
+    std::atomic_int total{};
+
+    ASSERT_EQ(0, group.serve(address, port, [&](uvw::tcp_handle &conn, std::size_t pos) {
+        ASSERT_EQ(&conn.parent(), &group[pos]);
+        ++accepted[pos];
+        conn.close();
+
+        if(++total == 4) {
+            group.stop();
+        }
+    },
+                             uvw::loop_group::mode::IPC));
+
+    auto loop = uvw::loop::get_default();
+    connect(*loop, address, port, 4u);
+    loop->run();
+
+    group.join();
+
+    ASSERT_EQ(accepted[0u], 2);
+    ASSERT_EQ(accepted[1u], 2);
+}
+
+TEST(LoopGroup, ServeReusePort) {
+    const std::string address = std::string{"127.0.0.1"};
+    const unsigned int port = 4242;
+
+    uvw::loop_group group{2u};
+    std::atomic_int total{};
+
+    ASSERT_EQ(0, group.serve(address, port, [&](uvw::tcp_handle &conn, std::size_t pos) {
+        ASSERT_EQ(&conn.parent(), &group[pos]);
+        conn.close();
+
+        if(++total == 4) {
+            group.stop();
+        }
+    }));
+
+    auto loop = uvw::loop::get_default();
+    connect(*loop, address, port, 4u);
+    loop->run();
+
+    group.join();
+
+    ASSERT_EQ(total, 4);
+}
+
+TEST(LoopGroup, ServeError) {
+    uvw::loop_group group{2u};
+
+    ASSERT_NE(0, group.serve("not an address", 4242, [](uvw::tcp_handle &, std::size_t) { FAIL(); }));
+    ASSERT_FALSE(group[0u].alive());
+    ASSERT_FALSE(group[1u].alive());
+}
@@ -0,0 +1,133 @@
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <uvw/fs.h>
+#include <uvw/mmap_file.h>
+
+namespace {
+
+const std::string filename = std::string{TARGET_MMAP_FILE_DIR} + std::string{"/test.file"};
+
+std::vector<char> populate(uvw::loop &loop, std::size_t size) {
+    static constexpr auto mode_0644 = 0644;
+    auto req = loop.resource<uvw::file_req>();
+    std::vector<char> data(size);
+
+    for(std::size_t pos{}; pos < size; ++pos) {
+        data[pos] = static_cast<char>(pos % 251u);
+    }
+
+    auto flags = uvw::file_req::file_open_flags::CREAT | uvw::file_req::file_open_flags::WRONLY | uvw::file_req::file_open_flags::TRUNC;
+    const uv_buf_t buf = uv_buf_init(data.data(), static_cast<unsigned int>(size));
+
+    EXPECT_TRUE(req->open_sync(filename, flags, mode_0644));
+    EXPECT_EQ(req->write_sync(&buf, 1u, 0).second, size);
+    EXPECT_TRUE(req->close_sync());
+
+    return data;
+}
+
+} // namespace
+
+TEST(MmapFile, Read) {
+    auto loop = uvw::loop::get_default();
+    auto req = loop->resource<uvw::file_req>();
+    auto mapping = loop->resource<uvw::mmap_file>();
+    const auto data = populate(*loop, 100003u);
+
+    bool checkMmapEvent = false;
+
+    mapping->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    mapping->on<uvw::mmap_event>([&checkMmapEvent](const uvw::mmap_event &event, uvw::mmap_file &hndl) {
+        ASSERT_FALSE(checkMmapEvent);
+        ASSERT_EQ(event.type, uvw::mmap_event::mmap_type::PREFAULT);
+        ASSERT_EQ(event.offset, 100u);
+        ASSERT_EQ(event.length, hndl.size() - 100u);
+        // the request is no longer in progress when the event is emitted
+        ASSERT_EQ(0, hndl.unmap());
+        checkMmapEvent = true;
+    });
+
+    ASSERT_EQ(nullptr, mapping->data());
+    ASSERT_EQ(UV_EINVAL, mapping->prefault());
+
+    ASSERT_TRUE(req->open_sync(filename, uvw::file_req::file_open_flags::RDONLY, 0));
+    ASSERT_EQ(0, mapping->map(*req, uvw::mmap_file::access::READ, 4097));
+    ASSERT_EQ(UV_EBUSY, mapping->map(*req));
+    ASSERT_TRUE(req->close_sync());
+
+    ASSERT_EQ(mapping->size(), data.size() - 4097u);
+    ASSERT_EQ(std::string(mapping->data(), mapping->size()), std::string(data.data() + 4097u, data.size() - 4097u));
+
+    ASSERT_EQ(0, mapping->advise(uvw::mmap_file::advice::SEQUENTIAL));
+    ASSERT_EQ(0, mapping->advise(uvw::mmap_file::advice::WILLNEED, 5000u, 1u));
+    ASSERT_EQ(UV_EINVAL, mapping->advise(uvw::mmap_file::advice::WILLNEED, mapping->size()));
+    ASSERT_EQ(UV_EINVAL, mapping->advise(uvw::mmap_file::advice::WILLNEED, 0u, mapping->size() + 1u));
+
+    ASSERT_EQ(0, mapping->prefault(100u));
+    ASSERT_EQ(UV_EBUSY, mapping->unmap());
+
+    loop->run();
+
+    ASSERT_TRUE(checkMmapEvent);
+    ASSERT_EQ(nullptr, mapping->data());
+    ASSERT_EQ(mapping->size(), 0u);
+}
+
+TEST(MmapFile, Write) {
+    auto loop = uvw::loop::get_default();
+    auto req = loop->resource<uvw::file_req>();
+    auto mapping = loop->resource<uvw::mmap_file>();
+    auto data = populate(*loop, 10000u);
+
+    bool checkMmapEvent = false;
+
+    mapping->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    mapping->on<uvw::mmap_event>([&checkMmapEvent](const uvw::mmap_event &event, uvw::mmap_file &) {
+        ASSERT_FALSE(checkMmapEvent);
+        ASSERT_EQ(event.type, uvw::mmap_event::mmap_type::SYNC);
+        checkMmapEvent = true;
+    });
+
+    ASSERT_TRUE(req->open_sync(filename, uvw::file_req::file_open_flags::RDWR, 0));
+    ASSERT_EQ(0, mapping->map(*req, uvw::mmap_file::access::READ_WRITE, 0, 5000u));
+    ASSERT_EQ(mapping->size(), 5000u);
+
+    mapping->data()[4999u] = data[4999u] = '*';
+
+    ASSERT_TRUE(mapping->sync_sync(4999u, 1u));
+    ASSERT_EQ(0, mapping->sync());
+    ASSERT_EQ(UV_EINVAL, mapping->sync(5000u));
+
+    loop->run();
+
+    ASSERT_TRUE(checkMmapEvent);
+
+    std::vector<char> content(data.size());
+    const uv_buf_t buf = uv_buf_init(content.data(), static_cast<unsigned int>(content.size()));
+
+    ASSERT_EQ(req->read_sync(&buf, 1u, 0).second, data.size());
+    ASSERT_EQ(content, data);
+    ASSERT_TRUE(req->close_sync());
+}
+
+TEST(MmapFile, Error) {
+    auto loop = uvw::loop::get_default();
+    auto req = loop->resource<uvw::file_req>();
+    auto mapping = loop->resource<uvw::mmap_file>();
+
+    populate(*loop, 10u);
+
+    ASSERT_NE(0, mapping->map(uvw::file_handle{-1}));
+    ASSERT_NE(0, mapping->map(uvw::file_handle{-1}, uvw::mmap_file::access::READ, 0, 10u));
+    ASSERT_EQ(UV_EINVAL, mapping->map(uvw::file_handle{-1}, uvw::mmap_file::access::READ, -1));
+
+    ASSERT_TRUE(req->open_sync(filename, uvw::file_req::file_open_flags::RDONLY, 0));
+    ASSERT_EQ(UV_EINVAL, mapping->map(*req, uvw::mmap_file::access::READ, 10));
+    ASSERT_NE(0, mapping->map(*req, uvw::mmap_file::access::READ_WRITE));
+    ASSERT_EQ(nullptr, mapping->data());
+    ASSERT_TRUE(req->close_sync());
+}
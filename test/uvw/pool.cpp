@@ -0,0 +1,110 @@
+#include <memory>
+#include <gtest/gtest.h>
+#include <uvw/fs.h>
+#include <uvw/loop.h>
+#include <uvw/pool.h>
+
+TEST(BufferPool, Functionalities) {
+    uvw::buffer_pool pool{};
+
+    ASSERT_EQ(pool.cached(), 0u);
+    ASSERT_EQ(pool.outstanding(), 0u);
+
+    auto [ptr, size] = pool.allocate(1000u);
+
+    ASSERT_NE(ptr, nullptr);
+    ASSERT_EQ(size, 1024u);
+    ASSERT_EQ(pool.outstanding(), 1u);
+
+    uvw::buffer_pool::release(ptr);
+
+    ASSERT_EQ(pool.cached(), 1024u);
+    ASSERT_EQ(pool.outstanding(), 0u);
+
+    auto [other, other_size] = pool.allocate(512u);
+
+    ASSERT_EQ(other, ptr);
+    ASSERT_EQ(other_size, 1024u);
+    ASSERT_EQ(pool.cached(), 0u);
+
+    uvw::buffer_pool::release(other);
+    uvw::buffer_pool::release(nullptr);
+
+    ASSERT_EQ(pool.cached(), 1024u);
+
+    pool.clear();
+
+    ASSERT_EQ(pool.cached(), 0u);
+}
+
+TEST(BufferPool, HighWaterMark) {
+    uvw::buffer_pool pool{};
+    pool.high_water_mark(4096u);
+
+    ASSERT_EQ(pool.high_water_mark(), 4096u);
+
+    auto first = pool.acquire(4096u);
+    auto second = pool.acquire(4096u);
+
+    ASSERT_TRUE(first.get_deleter().pooled());
+    ASSERT_EQ(pool.outstanding(), 2u);
+
+    first.reset();
+    second.reset();
+
+    ASSERT_EQ(pool.cached(), 4096u);
+    ASSERT_EQ(pool.outstanding(), 0u);
+
+    pool.high_water_mark(0u);
+
+    ASSERT_EQ(pool.cached(), 0u);
+}
+
+TEST(BufferPool, Unpooled) {
+    uvw::buffer_pool pool{};
+    auto buf = pool.acquire(1u << 20u);
+
+    ASSERT_EQ(pool.outstanding(), 1u);
+
+    buf.reset();
+
+    ASSERT_EQ(pool.cached(), 0u);
+    ASSERT_EQ(pool.outstanding(), 0u);
+
+    std::unique_ptr<char[], uvw::buffer_deleter> plain{std::make_unique<char[]>(1u)};
+
+    ASSERT_FALSE(plain.get_deleter().pooled());
+}
+
+TEST(BufferPool, OutliveLoop) {
+    auto loop = uvw::loop::create();
+    auto buf = loop->buffers().acquire(64u);
+
+    ASSERT_EQ(loop->buffers().outstanding(), 1u);
+    ASSERT_EQ(0, loop->close());
+
+    loop.reset();
+    buf.reset();
+}
+
+TEST(BufferPool, RecycledResource) {
+    auto loop = uvw::loop::create();
+    auto req = loop->recycled_resource<uvw::fs_req>();
+    const auto *addr = req.get();
+
+    ASSERT_EQ(loop->buffers().outstanding(), 1u);
+
+    req.reset();
+
+    ASSERT_EQ(loop->buffers().outstanding(), 0u);
+    ASSERT_NE(loop->buffers().cached(), 0u);
+
+    auto other = loop->recycled_resource<uvw::fs_req>();
+
+    ASSERT_EQ(other.get(), addr);
+    ASSERT_EQ(loop->buffers().cached(), 0u);
+    ASSERT_EQ(loop->buffers().outstanding(), 1u);
+
+    other.reset();
+    ASSERT_EQ(0, loop->close());
+}
@@ -0,0 +1,140 @@
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <gtest/gtest.h>
+#include <uvw/fs.h>
+#include <uvw/scheduler.hpp>
+
+namespace {
+
+template<typename Func>
+struct receiver {
+    template<typename... Args>
+    void set_value(Args &&...args) {
+        func(std::forward<Args>(args)...);
+    }
+
+    void set_error(uvw::error_event event) {
+        *error = event.code();
+    }
+
+    Func func;
+    int *error;
+};
+
+template<typename Func>
+receiver<Func> make_receiver(Func func, int &error) {
+    return receiver<Func>{std::move(func), &error};
+}
+
+} // namespace
+
+TEST(Scheduler, Schedule) {
+    auto loop = uvw::loop::get_default();
+    auto queue = loop->resource<uvw::run_queue>();
+    auto scheduler = queue->scheduler();
+
+    bool checkCloseEvent = false;
+    int values{};
+    int error{};
+
+    queue->on<uvw::close_event>([&checkCloseEvent](const auto &, auto &) {
+        ASSERT_FALSE(checkCloseEvent);
+        checkCloseEvent = true;
+    });
+
+    ASSERT_TRUE(queue->running_in_this_thread());
+    ASSERT_EQ(scheduler, queue->scheduler());
+
+    auto op = uvw::connect(scheduler.schedule(), make_receiver([&values]() { ++values; }, error));
+
+    // the fast path completes inline on the loop thread
+    op.start();
+
+    ASSERT_EQ(values, 1);
+
+    queue->close();
+    loop->run();
+
+    ASSERT_EQ(error, 0);
+    ASSERT_TRUE(checkCloseEvent);
+}
+
+TEST(Scheduler, Algorithms) {
+    auto loop = uvw::loop::get_default();
+    auto queue = loop->resource<uvw::run_queue>();
+    auto scheduler = queue->scheduler();
+
+    int values{};
+    int error{};
+
+    auto offload = uvw::then(uvw::offload(scheduler, []() { return 21; }), [](int value) { return value * 2; });
+    auto request = uvw::async_request<uvw::fs_event, uvw::fs_req>(scheduler, [](auto &req) { req.stat("."); });
+    auto sender = uvw::when_all(std::move(offload), std::move(request), scheduler.schedule());
+
+    auto callback = [&values, &queue](std::tuple<int, uvw::fs_event, std::monostate> value) {
+        ASSERT_EQ(std::get<0>(value), 42);
+        ASSERT_EQ(std::get<1>(value).type, uvw::fs_req::fs_type::STAT);
+        ++values;
+        queue->close();
+    };
+
+    auto op = uvw::connect(std::move(sender), make_receiver(std::move(callback), error));
+
+    auto failure = uvw::then(uvw::async_request<uvw::fs_event, uvw::fs_req>(scheduler, [](auto &req) { req.stat("test.file.missing"); }), [](const uvw::fs_event &) { FAIL(); });
+    auto other = uvw::connect(uvw::when_all(std::move(failure), uvw::offload(scheduler, []() {})), make_receiver([](auto &&) { FAIL(); }, error));
+
+    op.start();
+    other.start();
+    loop->run();
+
+    ASSERT_EQ(values, 1);
+    ASSERT_EQ(error, UV_ENOENT);
+}
+
+TEST(Scheduler, ContinueOn) {
+    auto loop = uvw::loop::get_default();
+    auto queue = loop->resource<uvw::run_queue>();
+
+    std::shared_ptr<uvw::run_queue> remote{};
+    std::atomic_bool ready{};
+    std::thread::id id{};
+    int error{};
+
+    std::thread runner{[&remote, &ready, &id]() {
+        auto other = uvw::loop::create();
+        remote = other->resource<uvw::run_queue>();
+        id = std::this_thread::get_id();
+        ready = true;
+        other->run();
+    }};
+
+    while(!ready) {
+        std::this_thread::yield();
+    }
+
+    EXPECT_FALSE(remote->running_in_this_thread());
+
+    auto sender = uvw::then(uvw::offload(queue->scheduler(), []() { return 42; }), [&queue](int value) {
+        queue->close();
+        return value;
+    });
+
+    auto callback = [&remote, &id](int value) {
+        ASSERT_EQ(value, 42);
+        ASSERT_EQ(id, std::this_thread::get_id());
+        remote->close();
+    };
+
+    auto op = uvw::connect(uvw::continue_on(std::move(sender), remote->scheduler()), make_receiver(std::move(callback), error));
+
+    op.start();
+    loop->run();
+    runner.join();
+
+    ASSERT_EQ(error, 0);
+}
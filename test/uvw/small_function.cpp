@@ -0,0 +1,118 @@
+#include <array>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <gtest/gtest.h>
+#include <uvw/small_function.hpp>
+
+namespace {
+
+int free_function(int value) {
+    return value + 1;
+}
+
+} // namespace
+
+TEST(SmallFunction, Functionalities) {
+    static_assert(sizeof(uvw::small_function<void()>) == 3u * sizeof(void *));
+
+    uvw::small_function<int(int)> func{};
+
+    ASSERT_FALSE(func);
+
+    func = [](int value) { return value * 2; };
+
+    ASSERT_TRUE(func);
+    ASSERT_EQ(func(2), 4);
+
+    func = nullptr;
+
+    ASSERT_FALSE(func);
+
+    func = &free_function;
+
+    ASSERT_TRUE(func);
+    ASSERT_EQ(func(2), 3);
+
+    func = static_cast<int (*)(int)>(nullptr);
+
+    ASSERT_FALSE(func);
+
+    func = std::function<int(int)>{};
+
+    ASSERT_FALSE(func);
+}
+
+TEST(SmallFunction, Captures) {
+    auto shared = std::make_shared<int>(42);
+    uvw::small_function<int()> func{[shared]() { return *shared; }};
+
+    ASSERT_EQ(shared.use_count(), 2);
+    ASSERT_EQ(func(), 42);
+
+    auto copy = func;
+
+    ASSERT_EQ(shared.use_count(), 3);
+    ASSERT_EQ(copy(), 42);
+
+    auto other = std::move(func);
+
+    ASSERT_FALSE(func);
+    ASSERT_EQ(shared.use_count(), 3);
+    ASSERT_EQ(other(), 42);
+
+    copy = nullptr;
+    other = nullptr;
+
+    ASSERT_EQ(shared.use_count(), 1);
+}
+
+TEST(SmallFunction, LargeCaptures) {
+    std::array<int, 16u> data{};
+    data[15u] = 42;
+
+    uvw::small_function<int()> func{[data]() { return data[15u]; }};
+    auto copy = func;
+    auto other = std::move(func);
+
+    ASSERT_FALSE(func);
+    ASSERT_EQ(copy(), 42);
+    ASSERT_EQ(other(), 42);
+
+    other = copy;
+
+    ASSERT_EQ(other(), 42);
+}
+
+TEST(SmallFunction, Mutable) {
+    int counter{};
+    uvw::small_function<void(int &)> func{[calls = 0](int &value) mutable { value = ++calls; }};
+
+    func(counter);
+    func(counter);
+
+    ASSERT_EQ(counter, 2);
+}
+
+TEST(SmallFunction, Target) {
+    uvw::small_function<int(int)> func{};
+
+    ASSERT_EQ(func.target<int (*)(int)>(), nullptr);
+
+    func = &free_function;
+
+    ASSERT_NE(func.target<int (*)(int)>(), nullptr);
+    ASSERT_EQ(*func.target<int (*)(int)>(), &free_function);
+    ASSERT_EQ(func.target<std::function<int(int)>>(), nullptr);
+
+    std::array<int, 16u> data{};
+    data[15u] = 42;
+    auto large = [data](int value) { return data[15u] + value; };
+    func = large;
+
+    const auto &ref = func;
+
+    ASSERT_NE(ref.target<decltype(large)>(), nullptr);
+    ASSERT_EQ(ref.target<int (*)(int)>(), nullptr);
+    ASSERT_EQ((*ref.target<decltype(large)>())(1), 43);
+}
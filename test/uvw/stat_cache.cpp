@@ -0,0 +1,144 @@
+#include <cstddef>
+#include <string>
+#include <gtest/gtest.h>
+#include <uvw/fs.h>
+#include <uvw/stat_cache.h>
+#include <uvw/timer.h>
+
+namespace {
+
+const std::string filename = std::string{TARGET_STAT_CACHE_DIR} + std::string{"/test.file"};
+
+void populate(uvw::loop &loop, std::size_t size) {
+    static constexpr auto mode_0644 = 0644;
+    auto req = loop.resource<uvw::file_req>();
+    auto flags = uvw::file_req::file_open_flags::CREAT | uvw::file_req::file_open_flags::WRONLY | uvw::file_req::file_open_flags::TRUNC;
+    std::string data(size, '*');
+    const uv_buf_t buf = uv_buf_init(data.data(), static_cast<unsigned int>(size));
+
+    ASSERT_TRUE(req->open_sync(filename, flags, mode_0644));
+    ASSERT_EQ(req->write_sync(&buf, 1u, 0).second, size);
+    ASSERT_TRUE(req->close_sync());
+}
+
+} // namespace
+
+TEST(StatCache, Stat) {
+    auto loop = uvw::loop::get_default();
+    auto cache = loop->resource<uvw::stat_cache>();
+    auto timer = loop->resource<uvw::timer_handle>();
+
+    std::size_t misses{};
+    std::size_t hits{};
+
+    populate(*loop, 1u);
+
+    cache->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    cache->on<uvw::stat_cache_event>([&](const uvw::stat_cache_event &event, uvw::stat_cache &hndl) {
+        ASSERT_EQ(event.path, filename);
+        ASSERT_EQ(event.stat.st_size, 1u);
+
+        if(event.hit) {
+            ++hits;
+        } else if(++misses == 1u) {
+            // hits are served synchronously
+            hndl.stat(filename);
+            ASSERT_EQ(hits, 1u);
+        }
+    });
+
+    // concurrent misses share the same request
+    cache->stat(filename);
+    cache->stat(filename);
+
+    ASSERT_EQ(cache->size(), 0u);
+    ASSERT_EQ(cache->misses(), 2u);
+
+    loop->run();
+
+    ASSERT_EQ(misses, 2u);
+    ASSERT_EQ(hits, 1u);
+    ASSERT_EQ(cache->size(), 1u);
+    ASSERT_EQ(cache->hits(), 1u);
+    ASSERT_EQ(cache->misses(), 2u);
+
+    timer->on<uvw::timer_event>([](const auto &, auto &handle) {
+        handle.close();
+    });
+
+    // changes are detected through the parent directory, watches don't keep the loop alive though
+    populate(*loop, 3u);
+    timer->start(uvw::timer_handle::time{10}, uvw::timer_handle::time{0});
+    loop->run();
+
+    ASSERT_EQ(cache->size(), 0u);
+
+    cache->clear();
+    cache->on<uvw::stat_cache_event>([&misses](const uvw::stat_cache_event &event, uvw::stat_cache &) {
+        ASSERT_FALSE(event.hit);
+        ASSERT_EQ(event.stat.st_size, 3u);
+        ++misses;
+    });
+
+    cache->stat(filename);
+    loop->run();
+
+    ASSERT_EQ(misses, 3u);
+    ASSERT_EQ(cache->size(), 1u);
+
+    cache->invalidate(filename);
+
+    ASSERT_EQ(cache->size(), 0u);
+}
+
+TEST(StatCache, Expire) {
+    auto loop = uvw::loop::get_default();
+    auto cache = loop->resource<uvw::stat_cache>();
+    auto timer = loop->resource<uvw::timer_handle>();
+
+    std::size_t misses{};
+
+    populate(*loop, 1u);
+
+    cache->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    cache->on<uvw::stat_cache_event>([&misses](const uvw::stat_cache_event &event, uvw::stat_cache &) {
+        ASSERT_FALSE(event.hit);
+        ++misses;
+    });
+
+    timer->on<uvw::timer_event>([cache](const auto &, auto &handle) {
+        cache->stat(filename);
+        handle.close();
+    });
+
+    cache->ttl(uvw::loop::time{1});
+    cache->stat(filename);
+    timer->start(uvw::timer_handle::time{10}, uvw::timer_handle::time{0});
+
+    loop->run();
+
+    ASSERT_EQ(misses, 2u);
+    ASSERT_EQ(cache->hits(), 0u);
+    ASSERT_EQ(cache->misses(), 2u);
+}
+
+TEST(StatCache, Error) {
+    auto loop = uvw::loop::get_default();
+    auto cache = loop->resource<uvw::stat_cache>();
+
+    std::size_t errors{};
+
+    cache->on<uvw::stat_cache_event>([](const auto &, auto &) { FAIL(); });
+    cache->on<uvw::error_event>([&errors](const auto &, auto &) { ++errors; });
+
+    cache->stat(filename + ".missing");
+    cache->stat(std::string{TARGET_STAT_CACHE_DIR} + "/missing/test.file");
+
+    loop->run();
+
+    ASSERT_EQ(errors, 2u);
+    ASSERT_EQ(cache->size(), 0u);
+    ASSERT_EQ(cache->misses(), 2u);
+}
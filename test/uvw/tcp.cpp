@@ -1,5 +1,11 @@
+#include <algorithm>
+#include <array>
+#include <string>
+#include <type_traits>
+#include <vector>
 #include <gtest/gtest.h>
 #include <uvw/tcp.h>
+#include <uvw/timer_wheel.h>
 
 namespace {
 
@@ -7,6 +13,38 @@ auto custom_alloc_callback(const uvw::tcp_handle &, std::size_t suggested) {
     return std::make_pair(new char[suggested], suggested);
 }
 
+struct server_handler {
+    static void on(uvw::listen_event &, uvw::tcp_handle &handle) {
+        const std::shared_ptr<uvw::tcp_handle> socket = handle.parent().resource<uvw::tcp_handle>();
+
+        socket->on<uvw::error_event>([](const uvw::error_event &, uvw::tcp_handle &) { FAIL(); });
+        socket->on<uvw::data_event>([](const uvw::data_event &, uvw::tcp_handle &) { FAIL(); });
+        socket->on<uvw::close_event>([&handle](const uvw::close_event &, uvw::tcp_handle &) { handle.close(); });
+
+        ASSERT_EQ(0, handle.accept(*socket));
+        ASSERT_EQ(0, socket->read(uvw::static_handler<server_handler>{}));
+    }
+
+    static void on(uvw::data_event &event, uvw::tcp_handle &) {
+        received.append(event.data.get(), event.length);
+    }
+
+    static void on(uvw::end_event &, uvw::tcp_handle &sock) {
+        sock.close();
+    }
+
+    static inline std::string received{};
+};
+
+struct client_handler {
+    static void on(uvw::write_event &, uvw::tcp_handle &handle) {
+        ++writes;
+        handle.close();
+    }
+
+    static inline int writes{};
+};
+
 } // namespace
 
 TEST(TCP, Functionalities) {
@@ -66,6 +104,83 @@ TEST(TCP, ReadWrite) {
     loop->run();
 }
 
+TEST(TCP, ReadWritePooled) {
+    const std::string address = std::string{"127.0.0.1"};
+    const unsigned int port = 4242;
+
+    auto loop = uvw::loop::get_default();
+    auto server = loop->resource<uvw::tcp_handle>();
+    auto client = loop->resource<uvw::tcp_handle>();
+    bool received = false;
+
+    server->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+    client->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    server->on<uvw::listen_event>([&received](const uvw::listen_event &, uvw::tcp_handle &handle) {
+        const std::shared_ptr<uvw::tcp_handle> socket = handle.parent().resource<uvw::tcp_handle>();
+
+        socket->on<uvw::error_event>([](const uvw::error_event &, uvw::tcp_handle &) { FAIL(); });
+        socket->on<uvw::close_event>([&handle](const uvw::close_event &, uvw::tcp_handle &) { handle.close(); });
+        socket->on<uvw::end_event>([](const uvw::end_event &, uvw::tcp_handle &sock) { sock.close(); });
+
+        socket->on<uvw::data_event>([&received](const uvw::data_event &event, uvw::tcp_handle &sock) {
+            ASSERT_TRUE(event.data.get_deleter().pooled());
+            ASSERT_EQ(sock.parent().buffers().outstanding(), 1u);
+            received = true;
+        });
+
+        ASSERT_EQ(0, handle.accept(*socket));
+        ASSERT_EQ(0, socket->read());
+    });
+
+    client->on<uvw::write_event>([](const uvw::write_event &, uvw::tcp_handle &handle) {
+        handle.close();
+    });
+
+    client->on<uvw::connect_event>([](const uvw::connect_event &, uvw::tcp_handle &handle) {
+        auto dataWrite = std::unique_ptr<char[]>(new char[2]{'b', 'c'});
+        handle.write(std::move(dataWrite), 2);
+    });
+
+    ASSERT_EQ(0, (server->bind(address, port)));
+    ASSERT_EQ(0, server->listen());
+    ASSERT_EQ(0, (client->connect(address, port)));
+
+    loop->run();
+
+    ASSERT_TRUE(received);
+    ASSERT_EQ(loop->buffers().outstanding(), 0u);
+    ASSERT_NE(loop->buffers().cached(), 0u);
+}
+
+TEST(TCP, ReadWriteStaticHandler) {
+    const std::string address = std::string{"127.0.0.1"};
+    const unsigned int port = 4242;
+
+    auto loop = uvw::loop::get_default();
+    auto server = loop->resource<uvw::tcp_handle>();
+    auto client = loop->resource<uvw::tcp_handle>();
+
+    server->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+    server->on<uvw::listen_event>([](const auto &, auto &) { FAIL(); });
+    client->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+    client->on<uvw::write_event>([](const auto &, auto &) { FAIL(); });
+
+    client->on<uvw::connect_event>([](const uvw::connect_event &, uvw::tcp_handle &handle) {
+        auto dataWrite = std::unique_ptr<char[]>(new char[2]{'b', 'c'});
+        ASSERT_EQ(0, handle.write(uvw::static_handler<client_handler>{}, std::move(dataWrite), 2));
+    });
+
+    ASSERT_EQ(0, (server->bind(address, port)));
+    ASSERT_EQ(0, server->listen(uvw::static_handler<server_handler>{}));
+    ASSERT_EQ(0, (client->connect(address, port)));
+
+    loop->run();
+
+    ASSERT_EQ(server_handler::received, "bc");
+    ASSERT_EQ(client_handler::writes, 1);
+}
+
 TEST(TCP, ReadWriteCustomAlloc) {
     const std::string address = std::string{"127.0.0.1"};
     const unsigned int port = 4242;
@@ -111,6 +226,69 @@ TEST(TCP, ReadWriteCustomAlloc) {
     loop->run();
 }
 
+TEST(TCP, ReadWriteVectored) {
+    const std::string address = std::string{"127.0.0.1"};
+    const unsigned int port = 4242;
+
+    auto loop = uvw::loop::get_default();
+    auto server = loop->resource<uvw::tcp_handle>();
+    auto client = loop->resource<uvw::tcp_handle>();
+    std::string received{};
+    int writes = 0;
+
+    server->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+    client->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    server->on<uvw::listen_event>([&received](const uvw::listen_event &, uvw::tcp_handle &handle) {
+        const std::shared_ptr<uvw::tcp_handle> socket = handle.parent().resource<uvw::tcp_handle>();
+
+        socket->on<uvw::error_event>([](const uvw::error_event &, uvw::tcp_handle &) { FAIL(); });
+        socket->on<uvw::close_event>([&handle](const uvw::close_event &, uvw::tcp_handle &) { handle.close(); });
+        socket->on<uvw::end_event>([](const uvw::end_event &, uvw::tcp_handle &sock) { sock.close(); });
+
+        socket->on<uvw::data_event>([&received](const uvw::data_event &event, uvw::tcp_handle &) {
+            received.append(event.data.get(), event.length);
+        });
+
+        ASSERT_EQ(0, handle.accept(*socket));
+        ASSERT_EQ(0, socket->read());
+    });
+
+    client->on<uvw::write_event>([&writes](const uvw::write_event &, uvw::tcp_handle &handle) {
+        if(++writes == 2) {
+            handle.close();
+        }
+    });
+
+    client->on<uvw::connect_event>([](const uvw::connect_event &, uvw::tcp_handle &handle) {
+        static char header[] = "a";
+        static char body[] = "bc";
+        static char trailer[] = "d";
+
+        std::array tryBufs{uv_buf_init(header, 1), uv_buf_init(body, 2)};
+
+        ASSERT_EQ(3, handle.try_write(tryBufs));
+
+        std::array bufs{uv_buf_init(header, 1), uv_buf_init(body, 2), uv_buf_init(trailer, 1)};
+
+        ASSERT_EQ(0, handle.write(bufs));
+
+        std::vector<std::pair<std::unique_ptr<char[]>, unsigned int>> data{};
+        data.emplace_back(new char[2]{'e', 'f'}, 2);
+        data.emplace_back(new char[1]{'g'}, 1);
+
+        ASSERT_EQ(0, handle.write(std::move(data)));
+    });
+
+    ASSERT_EQ(0, (server->bind(address, port)));
+    ASSERT_EQ(0, server->listen());
+    ASSERT_EQ(0, (client->connect(address, port)));
+
+    loop->run();
+
+    ASSERT_EQ(received, "abcabcdefg");
+}
+
 TEST(TCP, SockPeer) {
     const std::string address = std::string{"127.0.0.1"};
     const unsigned int port = 4242;
@@ -189,6 +367,471 @@ TEST(TCP, Shutdown) {
     loop->run();
 }
 
+TEST(TCP, Timeouts) {
+    const std::string address = std::string{"127.0.0.1"};
+    const unsigned int port = 4242;
+
+    auto loop = uvw::loop::get_default();
+    auto wheel = loop->resource<uvw::timer_wheel>(uvw::timer_wheel::time{5});
+    auto server = loop->resource<uvw::tcp_handle>();
+    auto client = loop->resource<uvw::tcp_handle>();
+
+    bool checkReadTimeout = false;
+    bool checkLifetimeTimeout = false;
+
+    server->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+    client->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    server->on<uvw::listen_event>([&checkReadTimeout, &wheel](const uvw::listen_event &, uvw::tcp_handle &handle) {
+        const std::shared_ptr<uvw::tcp_handle> socket = handle.parent().resource<uvw::tcp_handle>();
+        std::size_t length{};
+
+        socket->on<uvw::error_event>([](const uvw::error_event &, uvw::tcp_handle &) { FAIL(); });
+        socket->on<uvw::close_event>([&handle](const uvw::close_event &, uvw::tcp_handle &) { handle.close(); });
+        socket->on<uvw::data_event>([length](const uvw::data_event &event, uvw::tcp_handle &) mutable { ASSERT_LE(length += event.length, 2u); });
+
+        socket->on<uvw::timeout_event>([&checkReadTimeout](const uvw::timeout_event &event, uvw::tcp_handle &sock) {
+            ASSERT_FALSE(checkReadTimeout);
+            ASSERT_EQ(event.type, uvw::tcp_handle::timeout_type::READ);
+
+            checkReadTimeout = true;
+            sock.close();
+        });
+
+        ASSERT_EQ(0, handle.accept(*socket));
+
+        socket->timeouts(wheel);
+
+        ASSERT_TRUE(socket->timeout(uvw::tcp_handle::timeout_type::READ, uvw::timer_wheel::time{20}));
+        ASSERT_EQ(0, socket->read());
+    });
+
+    client->on<uvw::timeout_event>([&checkLifetimeTimeout, &wheel](const uvw::timeout_event &event, uvw::tcp_handle &handle) {
+        ASSERT_FALSE(checkLifetimeTimeout);
+        ASSERT_EQ(event.type, uvw::tcp_handle::timeout_type::LIFETIME);
+
+        checkLifetimeTimeout = true;
+        handle.close();
+        wheel->close();
+    });
+
+    client->on<uvw::connect_event>([](const uvw::connect_event &, uvw::tcp_handle &handle) {
+        handle.write(std::unique_ptr<char[]>(new char[2]{'a', 'b'}), 2);
+    });
+
+    ASSERT_FALSE(client->timeout(uvw::tcp_handle::timeout_type::LIFETIME, uvw::timer_wheel::time{100}));
+
+    client->timeouts(wheel);
+
+    ASSERT_TRUE(client->timeout(uvw::tcp_handle::timeout_type::WRITE, uvw::timer_wheel::time{10}));
+    ASSERT_TRUE(client->timeout(uvw::tcp_handle::timeout_type::LIFETIME, uvw::timer_wheel::time{100}));
+    ASSERT_EQ(wheel->size(), 1u);
+
+    ASSERT_EQ(0, (server->bind(address, port)));
+    ASSERT_EQ(0, server->listen());
+    ASSERT_EQ(0, (client->connect(address, port)));
+
+    loop->run();
+
+    ASSERT_TRUE(checkReadTimeout);
+    ASSERT_TRUE(checkLifetimeTimeout);
+}
+
+TEST(TCP, Watermarks) {
+    const std::string address = std::string{"127.0.0.1"};
+    const unsigned int port = 4242;
+    static constexpr unsigned int chunk = 1u << 20u;
+
+    auto loop = uvw::loop::get_default();
+    auto server = loop->resource<uvw::tcp_handle>();
+    auto client = loop->resource<uvw::tcp_handle>();
+
+    bool checkPressureEvent = false;
+    bool checkDrainEvent = false;
+    int writes{};
+
+    server->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+    client->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    server->on<uvw::listen_event>([](const uvw::listen_event &, uvw::tcp_handle &handle) {
+        const std::shared_ptr<uvw::tcp_handle> socket = handle.parent().resource<uvw::tcp_handle>();
+
+        socket->on<uvw::error_event>([](const uvw::error_event &, uvw::tcp_handle &) { FAIL(); });
+        socket->on<uvw::close_event>([&handle](const uvw::close_event &, uvw::tcp_handle &) { handle.close(); });
+        socket->on<uvw::end_event>([](const uvw::end_event &, uvw::tcp_handle &sock) { sock.close(); });
+
+        ASSERT_EQ(0, handle.accept(*socket));
+        ASSERT_EQ(0, socket->read());
+    });
+
+    client->on<uvw::pressure_event>([&checkPressureEvent](const uvw::pressure_event &event, uvw::tcp_handle &handle) {
+        ASSERT_FALSE(checkPressureEvent);
+        ASSERT_GE(event.queued, 4u * chunk);
+        // the upstream (the client itself) stops reading
+        ASSERT_EQ(handle.raw()->read_cb, nullptr);
+
+        checkPressureEvent = true;
+    });
+
+    client->on<uvw::drain_event>([&checkDrainEvent](const uvw::drain_event &event, uvw::tcp_handle &handle) {
+        ASSERT_FALSE(checkDrainEvent);
+        ASSERT_LE(event.queued, chunk);
+        ASSERT_NE(handle.raw()->read_cb, nullptr);
+
+        checkDrainEvent = true;
+    });
+
+    client->on<uvw::write_event>([&writes](const uvw::write_event &, uvw::tcp_handle &handle) {
+        if(++writes == 32) {
+            handle.close();
+        }
+    });
+
+    client->on<uvw::connect_event>([](const uvw::connect_event &, uvw::tcp_handle &handle) {
+        handle.watermarks(4u * chunk, chunk, handle.shared_from_this());
+
+        ASSERT_EQ(0, handle.read());
+
+        for(auto next = 0; next < 32; ++next) {
+            handle.write(std::unique_ptr<char[]>(new char[chunk]{}), chunk);
+        }
+    });
+
+    ASSERT_EQ(0, (server->bind(address, port)));
+    ASSERT_EQ(0, server->listen());
+    ASSERT_EQ(0, (client->connect(address, port)));
+
+    loop->run();
+
+    ASSERT_TRUE(checkPressureEvent);
+    ASSERT_TRUE(checkDrainEvent);
+}
+
+TEST(TCP, Cork) {
+    const std::string address = std::string{"127.0.0.1"};
+    const unsigned int port = 4242;
+
+    auto loop = uvw::loop::get_default();
+    auto server = loop->resource<uvw::tcp_handle>();
+    auto client = loop->resource<uvw::tcp_handle>();
+
+    std::string expected{"abcdefghijklmn"};
+    std::string received{};
+    char borrowed[]{'k', 'l'};
+    int writes{};
+
+    expected.append(1u << 15u, 'z');
+    expected.push_back('o');
+
+    server->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+    client->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    server->on<uvw::listen_event>([&received](const uvw::listen_event &, uvw::tcp_handle &handle) {
+        const std::shared_ptr<uvw::tcp_handle> socket = handle.parent().resource<uvw::tcp_handle>();
+
+        socket->on<uvw::error_event>([](const uvw::error_event &, uvw::tcp_handle &) { FAIL(); });
+        socket->on<uvw::close_event>([&handle](const uvw::close_event &, uvw::tcp_handle &) { handle.close(); });
+        socket->on<uvw::end_event>([](const uvw::end_event &, uvw::tcp_handle &sock) { sock.close(); });
+        socket->on<uvw::data_event>([&received](const uvw::data_event &event, uvw::tcp_handle &) { received.append(event.data.get(), event.length); });
+
+        ASSERT_EQ(0, handle.accept(*socket));
+        ASSERT_EQ(0, socket->read());
+    });
+
+    client->on<uvw::write_event>([&writes](const uvw::write_event &, uvw::tcp_handle &handle) {
+        if(++writes == 14) {
+            ASSERT_EQ(0, handle.uncork());
+            ASSERT_FALSE(handle.corked());
+            handle.close();
+        }
+    });
+
+    client->on<uvw::connect_event>([&borrowed](const uvw::connect_event &, uvw::tcp_handle &handle) {
+        ASSERT_TRUE(handle.cork());
+        ASSERT_TRUE(handle.corked());
+
+        for(char next = 'a'; next < 'k'; ++next) {
+            ASSERT_EQ(0, handle.write(std::unique_ptr<char[]>(new char[1]{next}), 1));
+        }
+
+        ASSERT_EQ(0, handle.write(borrowed, 2));
+
+        std::vector<std::pair<std::unique_ptr<char[]>, unsigned int>> data{};
+        data.emplace_back(std::unique_ptr<char[]>(new char[1]{'m'}), 1);
+        data.emplace_back(std::unique_ptr<char[]>(new char[1]{'n'}), 1);
+
+        ASSERT_EQ(0, handle.write(std::move(data)));
+
+        // nothing is sent before the end of the loop iteration
+        ASSERT_EQ(handle.write_queue_size(), 0u);
+
+        // large writes aren't gathered but follow the data gathered so far
+        auto large = std::unique_ptr<char[]>(new char[1u << 15u]);
+        std::fill_n(large.get(), 1u << 15u, 'z');
+
+        ASSERT_EQ(0, handle.write(std::move(large), 1u << 15u));
+        ASSERT_EQ(0, handle.write(std::unique_ptr<char[]>(new char[1]{'o'}), 1));
+        ASSERT_EQ(0, handle.flush());
+    });
+
+    ASSERT_EQ(0, (server->bind(address, port)));
+    ASSERT_EQ(0, server->listen());
+    ASSERT_EQ(0, (client->connect(address, port)));
+
+    loop->run();
+
+    ASSERT_EQ(writes, 14);
+    ASSERT_EQ(received, expected);
+}
+
+TEST(TCP, CorkClose) {
+    const std::string address = std::string{"127.0.0.1"};
+    const unsigned int port = 4242;
+
+    auto loop = uvw::loop::get_default();
+    auto server = loop->resource<uvw::tcp_handle>();
+    auto client = loop->resource<uvw::tcp_handle>();
+
+    std::string received{};
+    int writes{};
+
+    server->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+    client->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    server->on<uvw::listen_event>([&received](const uvw::listen_event &, uvw::tcp_handle &handle) {
+        const std::shared_ptr<uvw::tcp_handle> socket = handle.parent().resource<uvw::tcp_handle>();
+
+        socket->on<uvw::error_event>([](const uvw::error_event &, uvw::tcp_handle &) { FAIL(); });
+        socket->on<uvw::close_event>([&handle](const uvw::close_event &, uvw::tcp_handle &) { handle.close(); });
+        socket->on<uvw::end_event>([](const uvw::end_event &, uvw::tcp_handle &sock) { sock.close(); });
+        socket->on<uvw::data_event>([&received](const uvw::data_event &event, uvw::tcp_handle &) { received.append(event.data.get(), event.length); });
+
+        ASSERT_EQ(0, handle.accept(*socket));
+        ASSERT_EQ(0, socket->read());
+    });
+
+    client->on<uvw::write_event>([&writes](const uvw::write_event &, uvw::tcp_handle &) { ++writes; });
+
+    client->on<uvw::connect_event>([](const uvw::connect_event &, uvw::tcp_handle &handle) {
+        ASSERT_TRUE(handle.cork());
+
+        for(char next = 'a'; next < 'd'; ++next) {
+            ASSERT_EQ(0, handle.write(std::unique_ptr<char[]>(new char[1]{next}), 1));
+        }
+
+        // gathered data are flushed rather than discarded
+        handle.close();
+    });
+
+    ASSERT_EQ(0, (server->bind(address, port)));
+    ASSERT_EQ(0, server->listen());
+    ASSERT_EQ(0, (client->connect(address, port)));
+
+    loop->run();
+
+    ASSERT_EQ(writes, 3);
+    ASSERT_EQ(received, "abc");
+
+    // nothing is left behind while the handle is still referenced
+    loop->walk([](auto &) { FAIL(); });
+}
+
+TEST(TCP, CorkWalk) {
+    const std::string address = std::string{"127.0.0.1"};
+    const unsigned int port = 4242;
+
+    auto loop = uvw::loop::get_default();
+    auto server = loop->resource<uvw::tcp_handle>();
+    auto client = loop->resource<uvw::tcp_handle>();
+
+    std::string received{};
+    int writes{};
+
+    server->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+    client->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    server->on<uvw::listen_event>([&received](const uvw::listen_event &, uvw::tcp_handle &handle) {
+        const std::shared_ptr<uvw::tcp_handle> socket = handle.parent().resource<uvw::tcp_handle>();
+
+        socket->on<uvw::error_event>([](const uvw::error_event &, uvw::tcp_handle &) { FAIL(); });
+        socket->on<uvw::close_event>([&handle](const uvw::close_event &, uvw::tcp_handle &) { handle.close(); });
+        socket->on<uvw::end_event>([](const uvw::end_event &, uvw::tcp_handle &sock) { sock.close(); });
+        socket->on<uvw::data_event>([&received](const uvw::data_event &event, uvw::tcp_handle &) { received.append(event.data.get(), event.length); });
+
+        ASSERT_EQ(0, handle.accept(*socket));
+        ASSERT_EQ(0, socket->read());
+    });
+
+    client->on<uvw::write_event>([&writes](const uvw::write_event &, uvw::tcp_handle &handle) {
+        if(++writes == 2) {
+            handle.close();
+        }
+    });
+
+    client->on<uvw::connect_event>([](const uvw::connect_event &, uvw::tcp_handle &handle) {
+        ASSERT_TRUE(handle.cork());
+
+        // the handles of the loop are closed from under the stream
+        handle.parent().walk([](auto &hndl) {
+            if constexpr(std::is_same_v<std::decay_t<decltype(hndl)>, uvw::check_handle>) {
+                hndl.close();
+            }
+        });
+
+        ASSERT_EQ(0, handle.write(std::unique_ptr<char[]>(new char[1]{'a'}), 1));
+        ASSERT_EQ(0, handle.write(std::unique_ptr<char[]>(new char[1]{'b'}), 1));
+    });
+
+    ASSERT_EQ(0, (server->bind(address, port)));
+    ASSERT_EQ(0, server->listen());
+    ASSERT_EQ(0, (client->connect(address, port)));
+
+    loop->run();
+
+    ASSERT_EQ(writes, 2);
+    ASSERT_EQ(received, "ab");
+
+    loop->walk([](auto &) { FAIL(); });
+}
+
+TEST(TCP, EagerWrites) {
+    const std::string address = std::string{"127.0.0.1"};
+    const unsigned int port = 4242;
+
+    auto loop = uvw::loop::get_default();
+    auto server = loop->resource<uvw::tcp_handle>();
+    auto client = loop->resource<uvw::tcp_handle>();
+
+    std::string expected{"abcde"};
+    std::string received{};
+    char borrowed[]{'b', 'c'};
+    int writes{};
+
+    expected.append(1u << 21u, 'y');
+    expected.append(1u << 21u, 'z');
+    expected.push_back('f');
+
+    server->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+    client->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    server->on<uvw::listen_event>([&received](const uvw::listen_event &, uvw::tcp_handle &handle) {
+        const std::shared_ptr<uvw::tcp_handle> socket = handle.parent().resource<uvw::tcp_handle>();
+
+        socket->on<uvw::error_event>([](const uvw::error_event &, uvw::tcp_handle &) { FAIL(); });
+        socket->on<uvw::close_event>([&handle](const uvw::close_event &, uvw::tcp_handle &) { handle.close(); });
+        socket->on<uvw::end_event>([](const uvw::end_event &, uvw::tcp_handle &sock) { sock.close(); });
+        socket->on<uvw::data_event>([&received](const uvw::data_event &event, uvw::tcp_handle &) { received.append(event.data.get(), event.length); });
+
+        ASSERT_EQ(0, handle.accept(*socket));
+        ASSERT_EQ(0, socket->read());
+    });
+
+    client->on<uvw::write_event>([&writes](const uvw::write_event &, uvw::tcp_handle &handle) {
+        if(++writes == 5) {
+            handle.close();
+        }
+    });
+
+    client->on<uvw::connect_event>([&borrowed, &writes](const uvw::connect_event &, uvw::tcp_handle &handle) {
+        ASSERT_FALSE(handle.eager_writes());
+        ASSERT_TRUE(handle.eager_writes(true));
+        ASSERT_TRUE(handle.eager_writes());
+
+        ASSERT_EQ(0, handle.write(std::unique_ptr<char[]>(new char[1]{'a'}), 1));
+        ASSERT_EQ(0, handle.write(borrowed, 2));
+
+        std::vector<std::pair<std::unique_ptr<char[]>, unsigned int>> data{};
+        data.emplace_back(std::unique_ptr<char[]>(new char[1]{'d'}), 1);
+        data.emplace_back(std::unique_ptr<char[]>(new char[1]{'e'}), 1);
+
+        ASSERT_EQ(0, handle.write(std::move(data)));
+
+        // small writes went straight to the socket
+        ASSERT_EQ(handle.write_queue_size(), 0u);
+
+        // only the data that don't fit the socket buffers are queued
+        std::vector<std::pair<std::unique_ptr<char[]>, unsigned int>> large{};
+        large.emplace_back(std::unique_ptr<char[]>(new char[1u << 21u]), 1u << 21u);
+        large.emplace_back(std::unique_ptr<char[]>(new char[1u << 21u]), 1u << 21u);
+        std::fill_n(large[0u].first.get(), 1u << 21u, 'y');
+        std::fill_n(large[1u].first.get(), 1u << 21u, 'z');
+
+        ASSERT_EQ(0, handle.write(std::move(large)));
+        ASSERT_LT(handle.write_queue_size(), 1u << 22u);
+        ASSERT_EQ(0, handle.write(std::unique_ptr<char[]>(new char[1]{'f'}), 1));
+
+        // events are never emitted from within a write
+        ASSERT_EQ(writes, 0);
+    });
+
+    ASSERT_EQ(0, (server->bind(address, port)));
+    ASSERT_EQ(0, server->listen());
+    ASSERT_EQ(0, (client->connect(address, port)));
+
+    loop->run();
+
+    ASSERT_EQ(writes, 5);
+    ASSERT_EQ(received, expected);
+}
+
+TEST(TCP, EagerWritesVectored) {
+    const std::string address = std::string{"127.0.0.1"};
+    const unsigned int port = 4242;
+
+    auto loop = uvw::loop::get_default();
+    auto server = loop->resource<uvw::tcp_handle>();
+    auto client = loop->resource<uvw::tcp_handle>();
+
+    std::string small{"ab"};
+    std::string first(1u << 21u, 'y');
+    std::string second(1u << 21u, 'z');
+    std::string received{};
+    int writes{};
+
+    server->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+    client->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    server->on<uvw::listen_event>([&received](const uvw::listen_event &, uvw::tcp_handle &handle) {
+        const std::shared_ptr<uvw::tcp_handle> socket = handle.parent().resource<uvw::tcp_handle>();
+
+        socket->on<uvw::error_event>([](const uvw::error_event &, uvw::tcp_handle &) { FAIL(); });
+        socket->on<uvw::close_event>([&handle](const uvw::close_event &, uvw::tcp_handle &) { handle.close(); });
+        socket->on<uvw::end_event>([](const uvw::end_event &, uvw::tcp_handle &sock) { sock.close(); });
+        socket->on<uvw::data_event>([&received](const uvw::data_event &event, uvw::tcp_handle &) { received.append(event.data.get(), event.length); });
+
+        ASSERT_EQ(0, handle.accept(*socket));
+        ASSERT_EQ(0, socket->read());
+    });
+
+    client->on<uvw::write_event>([&writes](const uvw::write_event &, uvw::tcp_handle &handle) {
+        if(++writes == 2) {
+            handle.close();
+        }
+    });
+
+    client->on<uvw::connect_event>([&](const uvw::connect_event &, uvw::tcp_handle &handle) {
+        ASSERT_TRUE(handle.eager_writes(true));
+
+        const std::array<uv_buf_t, 2u> head{uv_buf_init(small.data(), 1u), uv_buf_init(small.data() + 1u, 1u)};
+        ASSERT_EQ(0, handle.write(head));
+        ASSERT_EQ(handle.write_queue_size(), 0u);
+
+        // borrowed buffers sent in part are queued from where the kernel stopped
+        const std::array<uv_buf_t, 2u> tail{uv_buf_init(first.data(), 1u << 21u), uv_buf_init(second.data(), 1u << 21u)};
+        ASSERT_EQ(0, handle.write(tail));
+        ASSERT_LT(handle.write_queue_size(), 1u << 22u);
+    });
+
+    ASSERT_EQ(0, (server->bind(address, port)));
+    ASSERT_EQ(0, server->listen());
+    ASSERT_EQ(0, (client->connect(address, port)));
+
+    loop->run();
+
+    ASSERT_EQ(writes, 2);
+    ASSERT_EQ(received, small + first + second);
+}
+
 TEST(TCP, WriteError) {
     auto loop = uvw::loop::get_default();
     auto handle = loop->resource<uvw::tcp_handle>();
@@ -200,4 +843,10 @@ TEST(TCP, WriteError) {
 
     ASSERT_LT(handle->try_write(std::unique_ptr<char[]>{}, 0), 0);
     ASSERT_LT(handle->try_write(nullptr, 0), 0);
+
+    std::array<uv_buf_t, 1u> bufs{uv_buf_init(nullptr, 0)};
+
+    ASSERT_NE(0, handle->write(bufs));
+    ASSERT_NE(0, handle->write(std::vector<std::pair<std::unique_ptr<char[]>, unsigned int>>{}));
+    ASSERT_LT(handle->try_write(bufs), 0);
 }
@@ -0,0 +1,131 @@
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include <gtest/gtest.h>
+#include <uvw/timer_wheel.h>
+
+TEST(TimerWheel, StartAndStop) {
+    auto loop = uvw::loop::get_default();
+    auto wheel = loop->resource<uvw::timer_wheel>(uvw::timer_wheel::time{1});
+
+    bool checkCloseEvent = false;
+    std::vector<void *> expired{};
+    int first{};
+    int second{};
+    int third{};
+
+    wheel->on<uvw::close_event>([&checkCloseEvent](const auto &, auto &) {
+        ASSERT_FALSE(checkCloseEvent);
+        checkCloseEvent = true;
+    });
+
+    wheel->on<uvw::timer_wheel_event>([&expired](const auto &event, auto &hndl) {
+        for(auto &&elem: event.expired) {
+            ASSERT_FALSE(hndl.active(elem.token));
+            expired.push_back(elem.data);
+        }
+
+        if(hndl.size() == 0u) {
+            hndl.close();
+        }
+    });
+
+    ASSERT_EQ(wheel->granularity(), uvw::timer_wheel::time{1});
+
+    const auto tkn = wheel->start(uvw::timer_wheel::time{5}, &first);
+    const auto other = wheel->start(uvw::timer_wheel::time{2}, &second);
+    const auto last = wheel->start(uvw::timer_wheel::time{20}, &third);
+
+    ASSERT_TRUE(tkn);
+    ASSERT_NE(tkn, other);
+    ASSERT_FALSE(uvw::timer_token{});
+    ASSERT_EQ(wheel->size(), 3u);
+
+    ASSERT_TRUE(wheel->stop(last));
+    ASSERT_FALSE(wheel->stop(last));
+    ASSERT_FALSE(wheel->active(last));
+    ASSERT_FALSE(wheel->again(last, uvw::timer_wheel::time{1}));
+
+    ASSERT_TRUE(wheel->again(other, uvw::timer_wheel::time{10}));
+    ASSERT_TRUE(wheel->active(other));
+    ASSERT_EQ(wheel->size(), 2u);
+
+    loop->run();
+
+    ASSERT_EQ(expired.size(), 2u);
+    ASSERT_EQ(expired[0u], &first);
+    ASSERT_EQ(expired[1u], &second);
+    ASSERT_FALSE(wheel->stop(tkn));
+    ASSERT_TRUE(checkCloseEvent);
+}
+
+TEST(TimerWheel, Cascade) {
+    auto loop = uvw::loop::get_default();
+    auto wheel = loop->resource<uvw::timer_wheel>(uvw::timer_wheel::time{1});
+    const auto begin = loop->now();
+
+    bool checkTimerWheelEvent = false;
+
+    wheel->on<uvw::timer_wheel_event>([&checkTimerWheelEvent, begin](const auto &event, auto &hndl) {
+        ASSERT_FALSE(checkTimerWheelEvent);
+        ASSERT_EQ(event.expired.size(), 1u);
+        ASSERT_GE(hndl.parent().now() - begin, uvw::loop::time{300});
+
+        checkTimerWheelEvent = true;
+        hndl.close();
+    });
+
+    // longer than a revolution of the innermost wheel
+    wheel->start(uvw::timer_wheel::time{300});
+    loop->run();
+
+    ASSERT_TRUE(checkTimerWheelEvent);
+}
+
+TEST(TimerWheel, Batch) {
+    auto loop = uvw::loop::get_default();
+    auto wheel = loop->resource<uvw::timer_wheel>();
+
+    std::size_t events{};
+    std::size_t expired{};
+
+    wheel->on<uvw::timer_wheel_event>([&events, &expired](const auto &event, auto &hndl) {
+        expired += event.expired.size();
+        ++events;
+        hndl.close();
+    });
+
+    for(std::size_t pos{}; pos < 1024u; ++pos) {
+        wheel->start(uvw::timer_wheel::time{20});
+    }
+
+    ASSERT_EQ(wheel->size(), 1024u);
+
+    loop->run();
+
+    ASSERT_EQ(events, 1u);
+    ASSERT_EQ(expired, 1024u);
+}
+
+TEST(TimerWheel, Wakeups) {
+    auto loop = uvw::loop::get_default();
+    auto wheel = loop->resource<uvw::timer_wheel>(uvw::timer_wheel::time{1});
+    uvw::timer_handle::time due{};
+
+    wheel->on<uvw::timer_wheel_event>([](const auto &, auto &hndl) {
+        hndl.close();
+    });
+
+    wheel->start(uvw::timer_wheel::time{300});
+
+    loop->walk([&due](auto &hndl) {
+        if constexpr(std::is_same_v<std::decay_t<decltype(hndl)>, uvw::timer_handle>) {
+            due = hndl.due_in();
+        }
+    });
+
+    // the wheel doesn't tick while there is nothing to do
+    ASSERT_GT(due, uvw::timer_handle::time{200});
+
+    loop->run();
+}
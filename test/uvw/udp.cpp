@@ -1,3 +1,5 @@
+#include <array>
+#include <string>
 #include <gtest/gtest.h>
 #include <uvw/udp.h>
 
@@ -7,6 +9,15 @@ auto custom_alloc_callback(const uvw::udp_handle &, std::size_t suggested) {
     return std::make_pair(new char[suggested], suggested);
 }
 
+struct udp_handler {
+    static void on(uvw::udp_data_event &event, uvw::udp_handle &handle) {
+        received = event.data[0];
+        handle.close();
+    }
+
+    static inline char received{};
+};
+
 } // namespace
 
 TEST(UDP, Functionalities) {
@@ -141,6 +152,193 @@ TEST(UDP, ReadSendCustomAlloc) {
     loop->run();
 }
 
+TEST(UDP, ReplyToSender) {
+    const std::string address = std::string{"127.0.0.1"};
+    const unsigned int port = 4242;
+
+    auto loop = uvw::loop::get_default();
+    auto server = loop->resource<uvw::udp_handle>();
+    auto client = loop->resource<uvw::udp_handle>();
+
+    server->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+    client->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    server->on<uvw::udp_data_event>([](const uvw::udp_data_event &event, uvw::udp_handle &handle) {
+        ASSERT_EQ(event.sender.family(), AF_INET);
+        ASSERT_EQ(event.sender.ip(), "127.0.0.1");
+        ASSERT_EQ(1, handle.try_send(event.sender, event.data.get(), 1));
+        handle.send(event.sender, std::unique_ptr<char[]>{}, 0);
+    });
+
+    server->on<uvw::send_event>([](const uvw::send_event &, uvw::udp_handle &handle) {
+        handle.close();
+    });
+
+    client->on<uvw::udp_data_event>([](const uvw::udp_data_event &event, uvw::udp_handle &handle) {
+        ASSERT_EQ(event.sender.port(), 4242u);
+        ASSERT_EQ(event.data[0], 'f');
+        handle.close();
+    });
+
+    ASSERT_EQ(0, (server->bind(address, port)));
+    ASSERT_EQ(0, server->recv());
+
+    char data = 'f';
+
+    ASSERT_EQ(1, client->try_send(uvw::raw_socket_address{address, port}, &data, 1));
+    ASSERT_EQ(0, client->recv());
+
+    loop->run();
+}
+
+TEST(UDP, SendBatch) {
+    const std::string address = std::string{"127.0.0.1"};
+    const unsigned int port = 4242;
+
+    auto loop = uvw::loop::get_default();
+    auto server = loop->resource<uvw::udp_handle>();
+    auto client = loop->resource<uvw::udp_handle>();
+    std::size_t received{};
+
+    server->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+    client->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    server->on<uvw::udp_data_event>([&received, &client](const uvw::udp_data_event &event, uvw::udp_handle &handle) {
+        ASSERT_EQ(event.length, 2u);
+        ASSERT_EQ(event.data[0], 'g');
+        ASSERT_EQ(event.data[1], 'h');
+
+        if(++received == 5u) {
+            client->close();
+            handle.close();
+        }
+    });
+
+    ASSERT_EQ(0, (server->bind(address, port)));
+    ASSERT_EQ(0, server->recv());
+
+    std::array<char, 2> data{'g', 'h'};
+    std::array bufs{uv_buf_init(&data[0], 1), uv_buf_init(&data[1], 1)};
+    const uvw::raw_socket_address addr{address, port};
+    std::array msgs{uvw::udp_message{addr, bufs.data(), 2}, uvw::udp_message{addr, bufs.data(), 2}, uvw::udp_message{addr, bufs.data(), 2}};
+
+    ASSERT_EQ(0, client->try_send_batch(msgs.data(), 0u));
+    ASSERT_EQ(0u, client->sock().port);
+
+    // the client isn't bound yet, it's bound implicitly
+    ASSERT_EQ(3, client->try_send_batch(msgs.data(), msgs.size()));
+    ASSERT_NE(0u, client->sock().port);
+    ASSERT_EQ(2, client->send_batch(msgs.data(), 2u));
+
+    loop->run();
+}
+
+TEST(UDP, ReadBatch) {
+    const std::string address = std::string{"127.0.0.1"};
+    const unsigned int port = 4242;
+
+    auto loop = uvw::loop::get_default();
+    auto server = loop->resource<uvw::udp_handle>(static_cast<unsigned int>(uvw::udp_handle::udp_flags::UDP_RECVMMSG));
+    auto client = loop->resource<uvw::udp_handle>();
+    std::string received{};
+
+    server->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+    client->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    server->on<uvw::udp_data_event>([](const auto &, auto &) { FAIL(); });
+
+    server->on<uvw::udp_batch_event>([&received, &client](const uvw::udp_batch_event &event, uvw::udp_handle &handle) {
+        ASSERT_FALSE(event.datagrams.empty());
+        // the receive buffer belongs to the handle, nothing comes from the pool
+        ASSERT_EQ(handle.parent().buffers().outstanding(), 0u);
+
+        for(auto &&datagram: event.datagrams) {
+            ASSERT_EQ(datagram.sender.ip(), "127.0.0.1");
+            ASSERT_FALSE(datagram.partial);
+            received.append(datagram.data, datagram.length);
+        }
+
+        if(received.size() == 3u) {
+            client->close();
+            handle.close();
+        }
+    });
+
+    ASSERT_EQ(UV_EINVAL, server->recv_batch(0u));
+    ASSERT_EQ(0, (server->bind(address, port)));
+    ASSERT_EQ(0, server->recv_batch());
+
+    std::array<char, 3> data{'a', 'b', 'c'};
+
+    for(auto &&elem: data) {
+        ASSERT_EQ(1, client->try_send(address, port, &elem, 1));
+    }
+
+    loop->run();
+
+    ASSERT_EQ(received, "abc");
+}
+
+TEST(UDP, ReadMmsgChunks) {
+    const std::string address = std::string{"127.0.0.1"};
+    const unsigned int port = 4242;
+
+    auto loop = uvw::loop::get_default();
+    auto server = loop->resource<uvw::udp_handle>(static_cast<unsigned int>(uvw::udp_handle::udp_flags::UDP_RECVMMSG));
+    auto client = loop->resource<uvw::udp_handle>();
+    std::string received{};
+
+    server->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+    client->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    server->on<uvw::udp_data_event>([&received, &client](const uvw::udp_data_event &event, uvw::udp_handle &handle) {
+        received.append(event.data.get(), event.length);
+
+        if(received.size() == 2u) {
+            client->close();
+            handle.close();
+        }
+    });
+
+    ASSERT_EQ(0, (server->bind(address, port)));
+    ASSERT_EQ(0, server->recv());
+
+    std::array<char, 2> data{'d', 'e'};
+
+    for(auto &&elem: data) {
+        ASSERT_EQ(1, client->try_send(address, port, &elem, 1));
+    }
+
+    loop->run();
+
+    ASSERT_EQ(received, "de");
+}
+
+TEST(UDP, ReadStaticHandler) {
+    const std::string address = std::string{"127.0.0.1"};
+    const unsigned int port = 4242;
+
+    auto loop = uvw::loop::get_default();
+    auto server = loop->resource<uvw::udp_handle>();
+    auto client = loop->resource<uvw::udp_handle>();
+
+    server->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+    server->on<uvw::udp_data_event>([](const auto &, auto &) { FAIL(); });
+    client->on<uvw::error_event>([](const auto &, auto &) { FAIL(); });
+
+    ASSERT_EQ(0, (server->bind(address, port)));
+    ASSERT_EQ(0, server->recv(uvw::static_handler<udp_handler>{}));
+
+    char data = 'i';
+
+    ASSERT_EQ(1, client->try_send(address, port, &data, 1));
+    client->close();
+
+    loop->run();
+
+    ASSERT_EQ(udp_handler::received, 'i');
+}
+
 TEST(UDP, Sock) {
     const std::string address = std::string{"127.0.0.1"};
     const unsigned int port = 4242;
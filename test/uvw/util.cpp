@@ -1,5 +1,6 @@
 #include <cstdlib>
 #include <memory>
+#include <type_traits>
 #include <gtest/gtest.h>
 #include <uvw.hpp>
 
@@ -105,3 +106,28 @@ TEST(Util, Utilities) {
 
     ASSERT_NE(uvw::utilities::available_parallelism(), 0u);
 }
+
+TEST(Util, RawSocketAddress) {
+    static_assert(std::is_trivially_copyable_v<uvw::raw_socket_address>);
+
+    const uvw::raw_socket_address invalid{};
+
+    ASSERT_EQ(invalid.family(), AF_UNSPEC);
+    ASSERT_EQ(invalid.port(), 0u);
+    ASSERT_TRUE(invalid.ip().empty());
+    ASSERT_EQ(uvw::raw_socket_address("not an ip", 4242).family(), AF_UNSPEC);
+
+    const uvw::raw_socket_address addr4{"127.0.0.1", 4242};
+    const uvw::raw_socket_address copy = addr4;
+
+    ASSERT_EQ(copy.family(), AF_INET);
+    ASSERT_EQ(copy.port(), 4242u);
+    ASSERT_EQ(copy.ip(), "127.0.0.1");
+    ASSERT_EQ(copy.address().port, 4242u);
+
+    const uvw::raw_socket_address addr6{*uvw::raw_socket_address{"::1", 4242}.raw()};
+
+    ASSERT_EQ(addr6.family(), AF_INET6);
+    ASSERT_EQ(addr6.port(), 4242u);
+    ASSERT_EQ(addr6.ip(), "::1");
+}